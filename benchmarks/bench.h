@@ -0,0 +1,147 @@
+#ifndef _MRT_COLLECTIONS_BENCH_H_
+#define _MRT_COLLECTIONS_BENCH_H_ 1
+
+#include <functional>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+
+namespace mrt {
+
+constexpr char BENCH_COLOR_RESET[] = "\u001b[0m";
+constexpr char BENCH_COLOR_CYAN[]  = "\u001b[36m";
+
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class BenchmarkFramework {
+ public:
+  using BenchmarkFunction = std::function<void()>;
+
+  struct Benchmark {
+    std::string name;
+    BenchmarkFunction fn;
+  };
+
+  struct Counter {
+    std::string name;
+    size_t value;
+  };
+
+  constexpr static size_t DEFAULT_ITERATIONS = 5;
+
+ public:
+  inline BenchmarkFramework(const std::string& name) : m_name(name) {}
+
+  inline ~BenchmarkFramework() = default;
+
+  inline void addBenchmark(const std::string& name, BenchmarkFunction fn) {
+    m_benchmarks.push_back({name, fn});
+  }
+
+  inline void addBenchmarks(std::vector<Benchmark> benchmarks) {
+    for (auto& benchmark : benchmarks) {
+      m_benchmarks.push_back(benchmark);
+    }
+  }
+
+  // Reports an extra value (e.g. allocation count) for the running benchmark, last run's value is printed
+  inline static void counter(const std::string& name, size_t value) {
+    for (auto& c : s_counters) {
+      if (c.name == name) {
+        c.value = value;
+        return;
+      }
+    }
+    s_counters.push_back({name, value});
+  }
+
+  // Bytes processed by one run of the running benchmark, throughput of the best run is printed in MB/s
+  inline static void bytes(size_t value) {
+    s_bytes = value;
+  }
+
+  inline int run(int argc, char ** argv) {
+    std::string benchmarkName;
+
+    if (argc > 1) {
+      for (size_t i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) {
+          printf(
+            "mrt.collections Benchmark Framework (benchmark '%s')\n"
+            "Usage: %s [OPTIONS] [BENCHMARK]\n"
+            "Options:\n"
+            "  -l, --list        - Prints list of benchmarks\n"
+            "  -n, --iterations  - Number of timed runs per benchmark\n",
+            m_name.c_str(), argv[0]
+          );
+          return 0;
+        } else if (!strcmp(argv[i], "-l") || !strcmp(argv[i], "--list")) {
+          for (auto& benchmark : m_benchmarks) {
+            printf("%s ", benchmark.name.c_str());
+          }
+          printf("\n");
+          return 0;
+        } else if ((!strcmp(argv[i], "-n") || !strcmp(argv[i], "--iterations")) && i + 1 < argc) {
+          m_iterations = strtoul(argv[++i], nullptr, 10);
+        } else {
+          benchmarkName = argv[i];
+        }
+      }
+    }
+
+    printf("Benchmark '%s'\n", m_name.c_str());
+    for (auto& benchmark : m_benchmarks) {
+      if (benchmarkName.empty() || benchmark.name == benchmarkName) {
+        runBenchmark(benchmark);
+      }
+    }
+
+    return 0;
+  }
+
+ private:
+  void runBenchmark(const Benchmark& benchmark) {
+    // Warm-up run, not measured
+    s_counters.clear();
+    s_bytes = 0;
+    benchmark.fn();
+
+    double best = 0, total = 0;
+    for (size_t i = 0; i < m_iterations; i++) {
+      auto start = std::chrono::steady_clock::now();
+      benchmark.fn();
+      auto end = std::chrono::steady_clock::now();
+      double ms = std::chrono::duration<double, std::milli>(end - start).count();
+      total += ms;
+      if (!i || ms < best) best = ms;
+    }
+
+    printf(
+      "[ %sBENCH%s ] %-48s best %10.3f ms  mean %10.3f ms\n",
+      BENCH_COLOR_CYAN, BENCH_COLOR_RESET, benchmark.name.c_str(), best, total / m_iterations
+    );
+    if (s_bytes && best > 0) {
+      printf("          %-48s %.1f MB/s\n", "throughput", s_bytes / (best * 1000.0));
+    }
+    for (auto& c : s_counters) {
+      printf("          %-48s %zu\n", c.name.c_str(), c.value);
+    }
+  }
+
+ private:
+  size_t m_iterations = DEFAULT_ITERATIONS;
+  std::string m_name;
+  std::vector<Benchmark> m_benchmarks;
+  inline static std::vector<Counter> s_counters;
+  inline static size_t s_bytes = 0;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_BENCH_H_ */
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include <mrt/allocator.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <mrt/map.h>
+#include <cstdlib>
+#include <new>
+
+constexpr size_t REQUESTS = 256;
+constexpr size_t ELEMENTS = 512;
+
+// Every global allocation is counted, so arena-backed runs should only show arena block allocations
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+  g_allocations++;
+  if (void* p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t size) noexcept {
+  std::free(p);
+}
+
+// One "request": builds an Array, a List and a Map, then drops them
+template <mrt::Allocator A>
+void request(const A& allocator) {
+  mrt::Array<int, A> arr(allocator);
+  mrt::List<int, A> list(allocator);
+  mrt::Map<int, int, A> map(allocator);
+
+  for (size_t i = 0; i < ELEMENTS; i++) {
+    arr.append((int) i);
+    list.append((int) i);
+    map.set((int) i, (int) i);
+  }
+
+  mrt::doNotOptimize(arr.size() + list.size() + map.size());
+}
+
+void bench_default() {
+  size_t start = g_allocations;
+  for (size_t i = 0; i < REQUESTS; i++) {
+    request(mrt::DefaultAllocator());
+  }
+  mrt::BenchmarkFramework::counter("allocations", g_allocations - start);
+}
+
+void bench_arena() {
+  size_t start = g_allocations;
+  for (size_t i = 0; i < REQUESTS; i++) {
+    mrt::MonotonicArena arena;
+    request(mrt::ArenaAllocator(arena));
+  }
+  mrt::BenchmarkFramework::counter("allocations", g_allocations - start);
+}
+
+void bench_arena_reused() {
+  size_t start = g_allocations;
+  mrt::MonotonicArena arena;
+  for (size_t i = 0; i < REQUESTS; i++) {
+    request(mrt::ArenaAllocator(arena));
+    arena.reset();
+  }
+  mrt::BenchmarkFramework::counter("allocations", g_allocations - start);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("allocator");
+
+  framework.addBenchmarks({
+    {"default", bench_default},
+    {"arena", bench_arena},
+    {"arena_reused", bench_arena_reused},
+  });
+
+  return framework.run(argc, argv);
+}
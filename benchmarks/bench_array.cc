@@ -0,0 +1,116 @@
+#include "bench.h"
+#include <mrt/array.h>
+#include <string>
+#include <vector>
+
+constexpr size_t COUNT = 1 << 20;
+constexpr size_t RECORD_COUNT = 1 << 17;
+
+struct Record {
+  std::string name;
+  std::vector<int> values;
+
+  Record() {}
+  Record(size_t i) : name("record-" + std::to_string(i)), values(16, (int) i) {}
+};
+
+// Reproduces the previous Array growth path: default-construct every slot, then copy-assign
+template <typename T>
+class LegacyArray {
+ public:
+  LegacyArray() { reserve(8); }
+  ~LegacyArray() { delete [] m_buffer; }
+
+  void append(const T& element) {
+    if (m_size + 1 >= m_capacity) {
+      reserve(m_capacity * 2);
+    }
+    m_buffer[m_size++] = element;
+  }
+
+  void reserve(size_t size) {
+    T* buffer = m_buffer;
+    m_buffer = new T[size];
+    for (size_t i = 0; i < m_size; i++) {
+      m_buffer[i] = buffer[i];
+    }
+    delete [] buffer;
+    m_capacity = size;
+  }
+
+  size_t size() const { return m_size; }
+
+ private:
+  size_t m_size = 0;
+  size_t m_capacity = 0;
+  T* m_buffer = nullptr;
+};
+
+void bench_legacy_append_int() {
+  LegacyArray<int> arr;
+  for (size_t i = 0; i < COUNT; i++) {
+    arr.append((int) i);
+  }
+  mrt::doNotOptimize(arr.size());
+}
+
+void bench_append_int() {
+  mrt::Array<int> arr;
+  for (size_t i = 0; i < COUNT; i++) {
+    arr.append((int) i);
+  }
+  mrt::doNotOptimize(arr.size());
+}
+
+void bench_legacy_append_record() {
+  LegacyArray<Record> arr;
+  for (size_t i = 0; i < RECORD_COUNT; i++) {
+    arr.append(Record(i));
+  }
+  mrt::doNotOptimize(arr.size());
+}
+
+void bench_append_record() {
+  mrt::Array<Record> arr;
+  for (size_t i = 0; i < RECORD_COUNT; i++) {
+    arr.append(Record(i));
+  }
+  mrt::doNotOptimize(arr.size());
+}
+
+void bench_emplace_record() {
+  mrt::Array<Record> arr;
+  for (size_t i = 0; i < RECORD_COUNT; i++) {
+    arr.emplace(i);
+  }
+  mrt::doNotOptimize(arr.size());
+}
+
+// Same appends under different growth policies, reallocations and unused capacity are reported
+template <mrt::GrowthPolicy G>
+void bench_append_growth() {
+  mrt::Array<Record, mrt::DefaultAllocator, G> arr;
+  for (size_t i = 0; i < RECORD_COUNT; i++) {
+    arr.emplace(i);
+  }
+  mrt::doNotOptimize(arr.size());
+  mrt::BenchmarkFramework::counter("reallocations", arr.stats().reallocations);
+  mrt::BenchmarkFramework::counter("slack (KB)", arr.stats().slack() / 1024);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("array");
+
+  framework.addBenchmarks({
+    {"legacy_append_int", bench_legacy_append_int},
+    {"append_int", bench_append_int},
+    {"legacy_append_record", bench_legacy_append_record},
+    {"append_record", bench_append_record},
+    {"emplace_record", bench_emplace_record},
+    {"append_growth_2", bench_append_growth<mrt::DoublingGrowth>},
+    {"append_growth_1.5", bench_append_growth<mrt::GeometricGrowth<3, 2>>},
+    {"append_growth_linear", bench_append_growth<mrt::LinearGrowth<4096>>},
+  });
+
+  return framework.run(argc, argv);
+}
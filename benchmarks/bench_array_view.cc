@@ -0,0 +1,55 @@
+#include "bench.h"
+#include <mrt/array_view.h>
+#include <mrt/array.h>
+#include <cstdint>
+
+constexpr size_t COUNT = 1 << 20;
+constexpr size_t WINDOW = 256;
+constexpr size_t WINDOWS = 1 << 14;
+
+mrt::Array<uint32_t>& values() {
+  static mrt::Array<uint32_t> arr;
+  if (!arr.size()) {
+    for (size_t i = 0; i < COUNT; i++) {
+      arr.append(i * 2654435761u);
+    }
+  }
+  return arr;
+}
+
+// Typical consumer of a sub-range, takes a view so both callers below can use it
+uint64_t checksum(mrt::ArrayView<uint32_t> window) {
+  return window.reduce<uint64_t>([](uint64_t s, const uint32_t& x) { return s * 31 + x; });
+}
+
+void slice() {
+  auto& arr = values();
+  uint64_t sum = 0;
+  for (size_t i = 0; i < WINDOWS; i++) {
+    size_t start = (i * 40503u) % (COUNT - WINDOW);
+    mrt::Array<uint32_t> window = arr.slice(start, start + WINDOW);
+    sum += checksum(window);
+  }
+  mrt::doNotOptimize(sum);
+}
+
+void view() {
+  auto& arr = values();
+  uint64_t sum = 0;
+  for (size_t i = 0; i < WINDOWS; i++) {
+    size_t start = (i * 40503u) % (COUNT - WINDOW);
+    sum += checksum(arr.view(start, start + WINDOW));
+  }
+  mrt::doNotOptimize(sum);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("array_view");
+
+  framework.addBenchmarks({
+    {"slice_window", slice},
+    {"view_window", view},
+  });
+
+  return framework.run(argc, argv);
+}
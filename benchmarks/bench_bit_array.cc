@@ -0,0 +1,78 @@
+#include "bench.h"
+#include <mrt/bit_array.h>
+#include <mrt/array.h>
+
+constexpr size_t COUNT = 1 << 24;
+
+struct Flags {
+  mrt::Array<bool> bytes1, bytes2;
+  mrt::BitArray bits1, bits2;
+
+  // Sparse flags, the only set one in bytes1/bits1 is the last
+  Flags() {
+    for (size_t i = 0; i < COUNT; i++) {
+      bytes1.append(i == COUNT - 1);
+      bytes2.append(i % 3 == 0);
+    }
+    bits1 = mrt::BitArray(bytes1);
+    bits2 = mrt::BitArray(bytes2);
+  }
+};
+
+Flags& flags() {
+  static Flags instance;
+  return instance;
+}
+
+void bool_array_count() {
+  auto& arr = flags().bytes2;
+  size_t count = 0;
+  for (size_t i = 0; i < arr.size(); i++) {
+    count += arr[i];
+  }
+  mrt::doNotOptimize(count);
+}
+
+void bit_array_count() {
+  mrt::doNotOptimize(flags().bits2.count());
+}
+
+void bool_array_find() {
+  mrt::doNotOptimize(flags().bytes1.lfind(true));
+}
+
+void bit_array_find() {
+  mrt::doNotOptimize(flags().bits1.findFirst());
+}
+
+void bool_array_and() {
+  auto& a = flags().bytes1;
+  auto& b = flags().bytes2;
+  mrt::Array<bool> result = mrt::Array<bool>::empty(a.size() + 1);
+  for (size_t i = 0; i < a.size(); i++) {
+    result.append(a[i] && b[i]);
+  }
+  mrt::doNotOptimize(result.data());
+}
+
+void bit_array_and() {
+  mrt::BitArray result = flags().bits1 & flags().bits2;
+  mrt::doNotOptimize(result.size());
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("bit_array");
+
+  flags();
+
+  framework.addBenchmarks({
+    {"bool_array_count", bool_array_count},
+    {"bit_array_count", bit_array_count},
+    {"bool_array_find", bool_array_find},
+    {"bit_array_find", bit_array_find},
+    {"bool_array_and", bool_array_and},
+    {"bit_array_and", bit_array_and},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,59 @@
+#include "bench.h"
+#include <mrt/concurrent_array.h>
+#include <mrt/array.h>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+constexpr size_t COUNT = 1 << 20;
+
+// COUNT appends split between Producers threads
+template <size_t Producers, typename F>
+void produce(F append) {
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < Producers; t++) {
+    threads.emplace_back([&append, t]() {
+      for (size_t i = t; i < COUNT; i += Producers) {
+        append(i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+template <size_t Producers>
+void locked_array() {
+  mrt::Array<size_t> arr;
+  std::mutex mutex;
+  produce<Producers>([&arr, &mutex](size_t i) {
+    std::lock_guard lock(mutex);
+    arr.append(i);
+  });
+  mrt::doNotOptimize(arr.size());
+}
+
+template <size_t Producers>
+void concurrent_array() {
+  mrt::ConcurrentArray<size_t> arr;
+  produce<Producers>([&arr](size_t i) { arr.append(i); });
+  mrt::doNotOptimize(arr.size());
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("concurrent_array");
+
+  framework.addBenchmarks({
+    {"locked_array_1", locked_array<1>},
+    {"concurrent_array_1", concurrent_array<1>},
+    {"locked_array_4", locked_array<4>},
+    {"concurrent_array_4", concurrent_array<4>},
+    {"locked_array_16", locked_array<16>},
+    {"concurrent_array_16", concurrent_array<16>},
+    {"locked_array_64", locked_array<64>},
+    {"concurrent_array_64", concurrent_array<64>},
+  });
+
+  return framework.run(argc, argv);
+}
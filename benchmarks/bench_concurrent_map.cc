@@ -0,0 +1,90 @@
+#include "bench.h"
+#include <mrt/concurrent_map.h>
+#include <mrt/map.h>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+constexpr uint32_t COUNT = 1 << 16;
+constexpr uint32_t OPERATIONS = 1 << 20;
+
+// Multiplication by an odd constant is a bijection on uint32_t, so keys are unique but scattered
+inline uint32_t key(uint32_t i) {
+  return i * 2654435761u;
+}
+
+// Baseline: single Map behind one lock
+class LockedMap {
+ public:
+  inline void set(uint32_t key, uint32_t value) {
+    std::lock_guard lock(m_mutex);
+    m_map.set(key, value);
+  }
+
+  inline uint32_t get(uint32_t key, uint32_t defaultValue) {
+    std::lock_guard lock(m_mutex);
+    return m_map.contains(key) ? m_map.get(key) : defaultValue;
+  }
+
+ private:
+  std::mutex m_mutex;
+  mrt::Map<uint32_t, uint32_t> m_map;
+};
+
+template <typename M>
+M& filledMap() {
+  static M map;
+  static bool filled = false;
+  if (!filled) {
+    for (uint32_t i = 0; i < COUNT; i++) {
+      map.set(key(i), i);
+    }
+    filled = true;
+  }
+  return map;
+}
+
+// OPERATIONS are split between threads, 90% reads and 10% writes
+template <typename M, size_t Threads>
+void mixed() {
+  M& map = filledMap<M>();
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < Threads; t++) {
+    threads.emplace_back([&map, t]() {
+      uint64_t sum = 0;
+      for (uint32_t i = 0; i < OPERATIONS / Threads; i++) {
+        uint32_t k = key((i * 40503u + t * 7919u) % COUNT);
+        if (i % 10 == 0) {
+          map.set(k, i);
+        } else {
+          sum += map.get(k, 0);
+        }
+      }
+      mrt::doNotOptimize(sum);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+using Concurrent = mrt::ConcurrentMap<uint32_t, uint32_t>;
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("concurrent_map");
+
+  framework.addBenchmarks({
+    {"locked_map_1", mixed<LockedMap, 1>},
+    {"locked_map_2", mixed<LockedMap, 2>},
+    {"locked_map_4", mixed<LockedMap, 4>},
+    {"locked_map_8", mixed<LockedMap, 8>},
+    {"concurrent_map_1", mixed<Concurrent, 1>},
+    {"concurrent_map_2", mixed<Concurrent, 2>},
+    {"concurrent_map_4", mixed<Concurrent, 4>},
+    {"concurrent_map_8", mixed<Concurrent, 8>},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,81 @@
+#include "bench.h"
+#include <mrt/cow.h>
+#include <mrt/array.h>
+#include <mrt/string.h>
+#include <string>
+
+constexpr size_t COUNT = 1 << 16;
+constexpr size_t CALLS = 1 << 10;
+constexpr size_t STRING_SIZE = 4096;
+
+template <typename C>
+C& filled() {
+  static C arr = [] {
+    mrt::Array<int> result;
+    for (size_t i = 0; i < COUNT; i++) {
+      result.append(i);
+    }
+    return C(std::move(result));
+  }();
+  return arr;
+}
+
+// Collections passed and stored by value, only every 64th call writes
+size_t useArray(mrt::Array<int> arr, size_t call) {
+  if (call % 64 == 0) arr[0] = call;
+  return arr.size() + arr[0];
+}
+
+size_t useCowArray(mrt::CowArray<int> arr, size_t call) {
+  if (call % 64 == 0) arr.mutate()[0] = call;
+  return arr->size() + (*arr)[0];
+}
+
+void array_by_value() {
+  size_t result = 0;
+  for (size_t i = 0; i < CALLS; i++) {
+    result += useArray(filled<mrt::Array<int>>(), i);
+  }
+  mrt::doNotOptimize(result);
+}
+
+void cow_array_by_value() {
+  size_t result = 0;
+  for (size_t i = 0; i < CALLS; i++) {
+    result += useCowArray(filled<mrt::CowArray<int>>(), i);
+  }
+  mrt::doNotOptimize(result);
+}
+
+void string_copies() {
+  mrt::String str(std::string(STRING_SIZE, 'x').c_str());
+  size_t result = 0;
+  for (size_t i = 0; i < CALLS; i++) {
+    mrt::String copy = str;
+    result += copy.size();
+  }
+  mrt::doNotOptimize(result);
+}
+
+void cow_string_copies() {
+  mrt::CowString str(mrt::String(std::string(STRING_SIZE, 'x').c_str()));
+  size_t result = 0;
+  for (size_t i = 0; i < CALLS; i++) {
+    mrt::CowString copy = str;
+    result += copy->size();
+  }
+  mrt::doNotOptimize(result);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("cow");
+
+  framework.addBenchmarks({
+    {"array_by_value", array_by_value},
+    {"cow_array_by_value", cow_array_by_value},
+    {"string_copies", string_copies},
+    {"cow_string_copies", cow_string_copies},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,86 @@
+#include "bench.h"
+#include <mrt/deque.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+
+constexpr size_t PREPEND_COUNT = 1 << 14;
+constexpr size_t QUEUE_OPS = 1 << 18;
+constexpr size_t QUEUE_DEPTH = 1024;
+
+void array_prepend() {
+  mrt::Array<int> arr;
+  for (size_t i = 0; i < PREPEND_COUNT; i++) {
+    arr.prepend(i);
+  }
+  mrt::doNotOptimize(arr[0]);
+}
+
+void list_prepend() {
+  mrt::List<int> list;
+  for (size_t i = 0; i < PREPEND_COUNT; i++) {
+    list.prepend(i);
+  }
+  mrt::doNotOptimize(list.size());
+}
+
+void deque_prepend() {
+  mrt::Deque<int> deque;
+  for (size_t i = 0; i < PREPEND_COUNT; i++) {
+    deque.prepend(i);
+  }
+  mrt::doNotOptimize(deque[0]);
+}
+
+// FIFO work queue holding QUEUE_DEPTH items: push to the back, take from the front
+void array_queue() {
+  mrt::Array<int> arr;
+  long sum = 0;
+  for (size_t i = 0; i < QUEUE_OPS; i++) {
+    arr.append(i);
+    if (arr.size() > QUEUE_DEPTH) {
+      sum += arr[0];
+      arr.remove(0);
+    }
+  }
+  mrt::doNotOptimize(sum);
+}
+
+void list_queue() {
+  mrt::List<int> list;
+  long sum = 0;
+  for (size_t i = 0; i < QUEUE_OPS; i++) {
+    list.append(i);
+    if (list.size() > QUEUE_DEPTH) {
+      sum += list[0];
+      list.remove(0);
+    }
+  }
+  mrt::doNotOptimize(sum);
+}
+
+void deque_queue() {
+  mrt::Deque<int> deque;
+  long sum = 0;
+  for (size_t i = 0; i < QUEUE_OPS; i++) {
+    deque.append(i);
+    if (deque.size() > QUEUE_DEPTH) {
+      sum += deque.popFront();
+    }
+  }
+  mrt::doNotOptimize(sum);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("deque");
+
+  framework.addBenchmarks({
+    {"array_prepend", array_prepend},
+    {"list_prepend", list_prepend},
+    {"deque_prepend", deque_prepend},
+    {"array_queue", array_queue},
+    {"list_queue", list_queue},
+    {"deque_queue", deque_queue},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,98 @@
+#include "bench.h"
+#include <mrt/generator.h>
+#include <mrt/flat_map.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <mrt/map.h>
+#include <functional>
+#include <cstdint>
+
+constexpr uint32_t COUNT = 1 << 20;
+constexpr uint32_t MAP_COUNT = 1 << 16;
+constexpr uint32_t SORT_COUNT = 1 << 16;
+
+// Erased runs pass the same lambda wrapped in std::function, which is what every call paid before
+template <bool Erased, typename F>
+auto wrap(F f) {
+  if constexpr (Erased) {
+    return std::function(f);
+  } else {
+    return f;
+  }
+}
+
+template <typename C>
+C& filled() {
+  static C c;
+  if (!c.size()) {
+    for (uint32_t i = 0; i < COUNT; i++) {
+      c.append(i * 2654435761u);
+    }
+  }
+  return c;
+}
+
+template <typename M>
+M& filledMap() {
+  static M map;
+  if (!map.size()) {
+    for (uint32_t i = 0; i < MAP_COUNT; i++) {
+      map.set(i * 2654435761u, i);
+    }
+  }
+  return map;
+}
+
+template <typename C, bool Erased>
+void pipeline() {
+  C& c = filled<C>();
+  auto filtered = c.filter(wrap<Erased>([](const uint32_t& x) { return (x & 1) != 0; }));
+  auto mapped = filtered.template map<uint32_t>(wrap<Erased>([](const uint32_t& x) { return x >> 3; }));
+  uint64_t sum = mapped.template reduce<uint64_t>(wrap<Erased>([](uint64_t s, const uint32_t& x) { return s + x; }));
+  mrt::doNotOptimize(sum);
+}
+
+template <typename M, bool Erased>
+void mapReduce() {
+  M& map = filledMap<M>();
+  uint64_t sum = 0;
+  for (int i = 0; i < 16; i++) {
+    sum += map.template reduce<uint64_t>(wrap<Erased>([](uint64_t s, const mrt::Pair<uint32_t, uint32_t>& p) { return s + p._2; }));
+  }
+  mrt::doNotOptimize(sum);
+}
+
+template <bool Erased>
+void generator() {
+  uint64_t sum = 0;
+  mrt::range(COUNT).foreach(wrap<Erased>([&sum](const size_t& x) { sum += x; }));
+  mrt::doNotOptimize(sum);
+}
+
+template <bool Erased>
+void sort() {
+  mrt::Array<uint32_t> arr = filled<mrt::Array<uint32_t>>().slice(SORT_COUNT);
+  arr.sort(wrap<Erased>([](uint32_t& lhs, uint32_t& rhs) { return lhs < rhs; }));
+  mrt::doNotOptimize(arr[0]);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("functional");
+
+  framework.addBenchmarks({
+    {"array_std_function", pipeline<mrt::Array<uint32_t>, true>},
+    {"array_template", pipeline<mrt::Array<uint32_t>, false>},
+    {"list_std_function", pipeline<mrt::List<uint32_t>, true>},
+    {"list_template", pipeline<mrt::List<uint32_t>, false>},
+    {"map_std_function", mapReduce<mrt::Map<uint32_t, uint32_t>, true>},
+    {"map_template", mapReduce<mrt::Map<uint32_t, uint32_t>, false>},
+    {"flat_map_std_function", mapReduce<mrt::FlatMap<uint32_t, uint32_t>, true>},
+    {"flat_map_template", mapReduce<mrt::FlatMap<uint32_t, uint32_t>, false>},
+    {"generator_std_function", generator<true>},
+    {"generator_template", generator<false>},
+    {"sort_std_function", sort<true>},
+    {"sort_template", sort<false>},
+  });
+
+  return framework.run(argc, argv);
+}
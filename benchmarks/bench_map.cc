@@ -0,0 +1,93 @@
+#include "bench.h"
+#include <mrt/flat_map.h>
+#include <mrt/map.h>
+#include <cstdint>
+#include <chrono>
+
+constexpr uint32_t COUNT = 1 << 20;
+constexpr uint32_t LOOKUPS = 1 << 22;
+constexpr uint32_t CHURN_ROUNDS = 16;
+
+// Multiplication by an odd constant is a bijection on uint32_t, so keys are unique but scattered
+inline uint32_t key(uint32_t i) {
+  return i * 2654435761u;
+}
+
+template <typename M>
+M& filledMap() {
+  static M map;
+  if (!map.size()) {
+    for (uint32_t i = 0; i < COUNT; i++) {
+      map.set(key(i), i);
+    }
+  }
+  return map;
+}
+
+template <typename M>
+void insert() {
+  M map;
+  for (uint32_t i = 0; i < COUNT; i++) {
+    map.set(key(i), i);
+  }
+  mrt::doNotOptimize(map.size());
+}
+
+template <typename M>
+void lookup() {
+  M& map = filledMap<M>();
+  uint64_t sum = 0;
+  // Lookup order differs from insertion order, so Map nodes aren't visited in allocation order
+  for (uint32_t i = 0; i < LOOKUPS; i++) {
+    sum += map.get(key((i * 40503u) % COUNT));
+  }
+  mrt::doNotOptimize(sum);
+}
+
+template <typename M>
+void churn() {
+  M map;
+  for (uint32_t round = 0; round < CHURN_ROUNDS; round++) {
+    for (uint32_t i = 0; i < COUNT / 16; i++) {
+      map.set(key(round * COUNT + i), i);
+    }
+    for (uint32_t i = 0; i < COUNT / 16; i++) {
+      map.remove(key(round * COUNT + i));
+    }
+  }
+  mrt::doNotOptimize(map.size());
+}
+
+// Worst single insert is reported, this is where a full rehash shows up
+template <bool Incremental>
+void insertLatency() {
+  mrt::Map<uint32_t, uint32_t> map;
+  map.setIncrementalResize(Incremental);
+  size_t worst = 0;
+  for (uint32_t i = 0; i < COUNT; i++) {
+    auto start = std::chrono::steady_clock::now();
+    map.set(key(i), i);
+    auto end = std::chrono::steady_clock::now();
+    size_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    if (ns > worst) worst = ns;
+  }
+  mrt::doNotOptimize(map.size());
+  mrt::BenchmarkFramework::counter("worst insert (us)", worst / 1000);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("map");
+
+  framework.addBenchmarks({
+    {"map_insert", insert<mrt::Map<uint32_t, uint32_t>>},
+    {"flat_map_insert", insert<mrt::FlatMap<uint32_t, uint32_t>>},
+    {"map_lookup", lookup<mrt::Map<uint32_t, uint32_t>>},
+    {"flat_map_lookup", lookup<mrt::FlatMap<uint32_t, uint32_t>>},
+    {"map_churn", churn<mrt::Map<uint32_t, uint32_t>>},
+    {"flat_map_churn", churn<mrt::FlatMap<uint32_t, uint32_t>>},
+    {"map_insert_latency", insertLatency<false>},
+    {"map_incremental_insert_latency", insertLatency<true>},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,75 @@
+#include "bench.h"
+#include <mrt/mapped_array.h>
+#include <mrt/array.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+constexpr size_t COUNT = 1 << 20;
+constexpr size_t LOOKUPS = 1 << 10;
+
+// Same table as a text source that has to be parsed, and as a file written by Array::save()
+struct Files {
+  std::string text = "/tmp/mrt_bench_mapped_" + std::to_string(getpid()) + ".txt";
+  std::string binary = "/tmp/mrt_bench_mapped_" + std::to_string(getpid()) + ".bin";
+
+  Files() {
+    mrt::Array<uint64_t> table = mrt::Array<uint64_t>::empty(COUNT + 1);
+    FILE* file = std::fopen(text.c_str(), "w");
+    for (uint64_t i = 0; i < COUNT; i++) {
+      table.append(i * 7);
+      std::fprintf(file, "%lu\n", (unsigned long) (i * 7));
+    }
+    std::fclose(file);
+    table.save(binary.c_str());
+  }
+
+  ~Files() {
+    std::remove(text.c_str());
+    std::remove(binary.c_str());
+  }
+};
+
+Files& files() {
+  static Files instance;
+  return instance;
+}
+
+template <typename C>
+uint64_t lookups(const C& table) {
+  uint64_t found = 0;
+  for (uint64_t i = 0; i < LOOKUPS; i++) {
+    found += table.binarySearch(i * 7919) != mrt::nidx;
+  }
+  return found;
+}
+
+void parse_startup() {
+  FILE* file = std::fopen(files().text.c_str(), "r");
+  mrt::Array<uint64_t> table;
+  unsigned long value;
+  while (std::fscanf(file, "%lu", &value) == 1) {
+    table.append(value);
+  }
+  std::fclose(file);
+  mrt::doNotOptimize(lookups(table));
+}
+
+void mapped_startup() {
+  mrt::MappedArray<uint64_t> table(files().binary.c_str());
+  mrt::doNotOptimize(lookups(table));
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("mapped_array");
+
+  files();
+
+  framework.addBenchmarks({
+    {"parse_startup", parse_startup},
+    {"mapped_startup", mapped_startup},
+  });
+
+  return framework.run(argc, argv);
+}
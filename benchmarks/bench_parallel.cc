@@ -0,0 +1,84 @@
+#include "bench.h"
+#include <mrt/thread_pool.h>
+#include <mrt/array.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cmath>
+
+constexpr size_t COUNT = 1 << 23;
+
+mrt::Array<double>& values() {
+  static mrt::Array<double> arr;
+  if (!arr.size()) {
+    arr.reserve(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+      arr.append((double) i);
+    }
+  }
+  return arr;
+}
+
+// Each element costs a few flops, so a run is neither purely memory nor purely compute bound
+void map(mrt::ThreadPool& pool) {
+  auto result = values().parallelMap<double>([](const double& x) { return std::sqrt(x) * 1.5 + 1.0; }, pool);
+  mrt::doNotOptimize(result.size());
+}
+
+void filter(mrt::ThreadPool& pool) {
+  auto result = values().parallelFilter([](const double& x) { return std::fmod(std::sqrt(x), 2.0) < 1.0; }, pool);
+  mrt::doNotOptimize(result.size());
+}
+
+void reduce(mrt::ThreadPool& pool) {
+  double sum = values().parallelReduce<double>(
+    [](double s, const double& x) { return s + std::sqrt(x); },
+    [](double a, double b) { return a + b; },
+    0.0, pool
+  );
+  mrt::doNotOptimize(sum);
+}
+
+// Plain single-threaded versions, the baseline for parallel ones
+void sequentialMap() {
+  auto result = values().map<double>([](const double& x) { return std::sqrt(x) * 1.5 + 1.0; });
+  mrt::doNotOptimize(result.size());
+}
+
+void sequentialFilter() {
+  auto result = values().filter([](const double& x) { return std::fmod(std::sqrt(x), 2.0) < 1.0; });
+  mrt::doNotOptimize(result.size());
+}
+
+void sequentialReduce() {
+  double sum = values().reduce<double>([](double s, const double& x) { return s + std::sqrt(x); }, 0.0);
+  mrt::doNotOptimize(sum);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("parallel");
+
+  framework.addBenchmarks({
+    {"sequential_map", sequentialMap},
+    {"sequential_filter", sequentialFilter},
+    {"sequential_reduce", sequentialReduce},
+  });
+
+  // 1, 2, 4, ... threads, up to and including the number of hardware threads
+  std::vector<std::unique_ptr<mrt::ThreadPool>> pools;
+  for (size_t threads = 1; ; threads *= 2) {
+    if (threads > mrt::ThreadPool::defaultThreads()) threads = mrt::ThreadPool::defaultThreads();
+    pools.push_back(std::make_unique<mrt::ThreadPool>(threads));
+    if (threads == mrt::ThreadPool::defaultThreads()) break;
+  }
+
+  for (auto& pool : pools) {
+    mrt::ThreadPool* p = pool.get();
+    std::string suffix = "_" + std::to_string(p->threads());
+    framework.addBenchmark("parallel_map" + suffix, [p]() { map(*p); });
+    framework.addBenchmark("parallel_filter" + suffix, [p]() { filter(*p); });
+    framework.addBenchmark("parallel_reduce" + suffix, [p]() { reduce(*p); });
+  }
+
+  return framework.run(argc, argv);
+}
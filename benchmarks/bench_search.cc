@@ -0,0 +1,78 @@
+#include "bench.h"
+#include <mrt/array.h>
+#include <cstdint>
+
+constexpr size_t COUNT = 1 << 20;
+constexpr size_t QUERIES = 64;
+
+template <typename T>
+mrt::Array<T>& values() {
+  static mrt::Array<T> arr;
+  if (!arr.size()) {
+    arr.reserve(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+      arr.append((T) (i % 1000));
+    }
+  }
+  return arr;
+}
+
+// Previous Array::contains, compiled with the same flags
+template <typename T>
+bool scalarContains(const mrt::Array<T>& arr, const T& value) {
+  for (size_t i = 0; i < arr.size(); i++) {
+    if (arr[i] == value) return true;
+  }
+  return false;
+}
+
+// Misses scan the whole array, which is the common case of a membership check
+template <typename T, bool Simd>
+void contains() {
+  auto& arr = values<T>();
+  size_t hits = 0;
+  for (size_t i = 0; i < QUERIES; i++) {
+    T missing = (T) (1000 + i);
+    hits += Simd ? arr.contains(missing) : scalarContains(arr, missing);
+  }
+  mrt::doNotOptimize(hits);
+}
+
+template <typename T, bool Simd>
+void find() {
+  auto& arr = values<T>();
+  size_t found = 0;
+  for (size_t i = 0; i < QUERIES / 8; i++) {
+    if constexpr (Simd) {
+      found += arr.find((T) i).size();
+    } else {
+      mrt::Array<size_t> indexes;
+      for (size_t j = 0; j < arr.size(); j++) {
+        if (arr[j] == (T) i) indexes.append(j);
+      }
+      found += indexes.size();
+    }
+  }
+  mrt::doNotOptimize(found);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("search");
+
+  framework.addBenchmarks({
+    {"contains_int_scalar", contains<int, false>},
+    {"contains_int_simd", contains<int, true>},
+    {"contains_float_scalar", contains<float, false>},
+    {"contains_float_simd", contains<float, true>},
+    {"contains_uint64_scalar", contains<uint64_t, false>},
+    {"contains_uint64_simd", contains<uint64_t, true>},
+    {"contains_uint16_scalar", contains<uint16_t, false>},
+    {"contains_uint16_simd", contains<uint16_t, true>},
+    {"find_int_scalar", find<int, false>},
+    {"find_int_simd", find<int, true>},
+    {"find_double_scalar", find<double, false>},
+    {"find_double_simd", find<double, true>},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,89 @@
+#include "bench.h"
+#include <mrt/segmented_array.h>
+#include <mrt/array.h>
+#include <string>
+#include <chrono>
+
+constexpr size_t COUNT = 1 << 20;
+constexpr size_t STRING_COUNT = 1 << 18;
+
+template <typename C>
+void appendInts() {
+  C arr;
+  for (size_t i = 0; i < COUNT; i++) {
+    arr.append(i);
+  }
+  mrt::doNotOptimize(arr[COUNT - 1]);
+}
+
+// Array moves every string when it grows, SegmentedArray never does
+template <typename C>
+void appendStrings() {
+  C arr;
+  for (size_t i = 0; i < STRING_COUNT; i++) {
+    arr.append(std::string(32, 'a' + i % 26));
+  }
+  mrt::doNotOptimize(arr[STRING_COUNT - 1]);
+}
+
+// Worst single append is reported, this is where Array's reallocation shows up
+template <typename C>
+void appendLatency() {
+  C arr;
+  size_t worst = 0;
+  for (size_t i = 0; i < COUNT; i++) {
+    auto start = std::chrono::steady_clock::now();
+    arr.append(i);
+    auto end = std::chrono::steady_clock::now();
+    size_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    if (ns > worst) worst = ns;
+  }
+  mrt::doNotOptimize(arr[COUNT - 1]);
+  mrt::BenchmarkFramework::counter("worst append (us)", worst / 1000);
+}
+
+template <typename C>
+C& filled() {
+  static C arr;
+  if (!arr.size()) {
+    for (size_t i = 0; i < COUNT; i++) {
+      arr.append(i);
+    }
+  }
+  return arr;
+}
+
+template <typename C>
+void sum() {
+  long result = filled<C>().reduce([](long acc, const size_t& x) { return acc + x; }, 0L);
+  mrt::doNotOptimize(result);
+}
+
+template <typename C>
+void indexedSum() {
+  C& arr = filled<C>();
+  long result = 0;
+  for (size_t i = 0; i < arr.size(); i++) {
+    result += arr[i];
+  }
+  mrt::doNotOptimize(result);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("segmented_array");
+
+  framework.addBenchmarks({
+    {"array_append", appendInts<mrt::Array<size_t>>},
+    {"segmented_array_append", appendInts<mrt::SegmentedArray<size_t>>},
+    {"array_append_strings", appendStrings<mrt::Array<std::string>>},
+    {"segmented_array_append_strings", appendStrings<mrt::SegmentedArray<std::string>>},
+    {"array_append_latency", appendLatency<mrt::Array<size_t>>},
+    {"segmented_array_append_latency", appendLatency<mrt::SegmentedArray<size_t>>},
+    {"array_sum", sum<mrt::Array<size_t>>},
+    {"segmented_array_sum", sum<mrt::SegmentedArray<size_t>>},
+    {"array_indexed_sum", indexedSum<mrt::Array<size_t>>},
+    {"segmented_array_indexed_sum", indexedSum<mrt::SegmentedArray<size_t>>},
+  });
+
+  return framework.run(argc, argv);
+}
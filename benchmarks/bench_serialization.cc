@@ -0,0 +1,84 @@
+#include "bench.h"
+#include <mrt/serialization.h>
+#include <mrt/string.h>
+#include <mrt/array.h>
+#include <mrt/map.h>
+#include <cstdint>
+#include <string>
+
+constexpr size_t COUNT = 1 << 20;
+constexpr size_t STRING_COUNT = 1 << 16;
+constexpr size_t MAP_COUNT = 1 << 15;
+
+mrt::Array<uint64_t>& numbers() {
+  static mrt::Array<uint64_t> arr;
+  if (!arr.size()) {
+    for (size_t i = 0; i < COUNT; i++) {
+      arr.append(i * 2654435761u);
+    }
+  }
+  return arr;
+}
+
+mrt::Array<mrt::String>& strings() {
+  static mrt::Array<mrt::String> arr;
+  if (!arr.size()) {
+    for (size_t i = 0; i < STRING_COUNT; i++) {
+      arr.append(mrt::String(("value-" + std::to_string(i * 7919)).c_str()));
+    }
+  }
+  return arr;
+}
+
+mrt::Map<int, double>& table() {
+  static mrt::Map<int, double> map;
+  if (!map.size()) {
+    for (size_t i = 0; i < MAP_COUNT; i++) {
+      map.set(i, i * 0.5);
+    }
+  }
+  return map;
+}
+
+template <typename T>
+mrt::Array<uint8_t>& encoded(const T& value) {
+  static mrt::Array<uint8_t> bytes;
+  if (!bytes.size()) {
+    mrt::BinaryWriter writer;
+    writer.write(value);
+    bytes = writer.buffer();
+  }
+  return bytes;
+}
+
+template <typename T>
+void encodeBench(const T& value) {
+  mrt::BinaryWriter writer;
+  writer.write(value);
+  mrt::BenchmarkFramework::bytes(writer.buffer().size());
+  mrt::doNotOptimize(writer.buffer().data());
+}
+
+template <typename T>
+void decodeBench(const T& value) {
+  auto& bytes = encoded(value);
+  mrt::BinaryReader reader(bytes);
+  T decoded = reader.read<T>();
+  mrt::BenchmarkFramework::bytes(bytes.size());
+  mrt::doNotOptimize(decoded.size());
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("serialization");
+
+  framework.addBenchmarks({
+    {"encode_u64_array", []() { encodeBench(numbers()); }},
+    {"decode_u64_array", []() { decodeBench(numbers()); }},
+    {"encode_string_array", []() { encodeBench(strings()); }},
+    {"decode_string_array", []() { decodeBench(strings()); }},
+    {"encode_map", []() { encodeBench(table()); }},
+    {"decode_map", []() { decodeBench(table()); }},
+  });
+
+  return framework.run(argc, argv);
+}
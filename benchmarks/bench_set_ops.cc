@@ -0,0 +1,86 @@
+#include "bench.h"
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <cstdint>
+
+constexpr uint32_t SMALL_COUNT = 1 << 14;
+constexpr uint32_t COUNT = 1 << 20;
+
+// Values repeat, so unique() keeps about a quarter of them
+template <typename C>
+C& filled(uint32_t count) {
+  static C c;
+  if (c.size() != count) {
+    c = C();
+    for (uint32_t i = 0; i < count; i++) {
+      c.append((i * 2654435761u) % (count / 4));
+    }
+  }
+  return c;
+}
+
+template <typename C>
+C& sortedFilled(uint32_t count) {
+  static C c;
+  if (c.size() != count) {
+    c = C();
+    for (uint32_t i = 0; i < count; i++) {
+      c.append(i / 4);
+    }
+  }
+  return c;
+}
+
+// Previous unique(): contains() on the result for every element
+template <typename C>
+C quadraticUnique(C& c) {
+  C result;
+  c.foreach([&result](const uint32_t& x) {
+    if (!result.contains(x)) result.append(x);
+  });
+  return result;
+}
+
+template <typename C, bool Quadratic>
+void unique() {
+  C& c = filled<C>(SMALL_COUNT);
+  if constexpr (Quadratic) {
+    mrt::doNotOptimize(quadraticUnique(c).size());
+  } else {
+    mrt::doNotOptimize(c.unique().size());
+  }
+}
+
+template <typename C>
+void uniqueLarge() {
+  mrt::doNotOptimize(filled<C>(COUNT).unique().size());
+}
+
+template <typename C>
+void uniqueSorted() {
+  mrt::doNotOptimize(sortedFilled<C>(COUNT).unique().size());
+}
+
+template <typename C>
+void intersect() {
+  C& c = filled<C>(COUNT);
+  mrt::doNotOptimize((c & c.unique()).size() + (c | c.unique()).size());
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("set_ops");
+
+  framework.addBenchmarks({
+    {"array_unique_quadratic_16k", unique<mrt::Array<uint32_t>, true>},
+    {"array_unique_hash_16k", unique<mrt::Array<uint32_t>, false>},
+    {"list_unique_quadratic_16k", unique<mrt::List<uint32_t>, true>},
+    {"list_unique_hash_16k", unique<mrt::List<uint32_t>, false>},
+    {"array_unique_1m", uniqueLarge<mrt::Array<uint32_t>>},
+    {"array_unique_sorted_1m", uniqueSorted<mrt::Array<uint32_t>>},
+    {"list_unique_1m", uniqueLarge<mrt::List<uint32_t>>},
+    {"array_and_or_1m", intersect<mrt::Array<uint32_t>>},
+    {"list_and_or_1m", intersect<mrt::List<uint32_t>>},
+  });
+
+  return framework.run(argc, argv);
+}
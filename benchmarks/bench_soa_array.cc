@@ -0,0 +1,90 @@
+#include "bench.h"
+#include <mrt/soa_array.h>
+#include <mrt/array.h>
+#include <cstdint>
+
+constexpr size_t COUNT = 1 << 20;
+
+// 64 byte record, scans below only read score (and id)
+struct Record {
+  uint32_t id;
+  float score;
+  double weight;
+  uint64_t flags[6];
+};
+
+mrt::Array<Record>& records() {
+  static mrt::Array<Record> arr;
+  if (!arr.size()) {
+    for (uint32_t i = 0; i < COUNT; i++) {
+      arr.append({i, (float) (i % 1000), i * 0.5, {i, i, i, i, i, i}});
+    }
+  }
+  return arr;
+}
+
+using Columns = mrt::SoAArray<uint32_t, float, double, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t>;
+
+Columns& columns() {
+  static Columns arr;
+  if (!arr.size()) {
+    arr.reserve(COUNT + 1);
+    for (uint32_t i = 0; i < COUNT; i++) {
+      arr.append(i, (float) (i % 1000), i * 0.5, i, i, i, i, i, i);
+    }
+  }
+  return arr;
+}
+
+void aos_sum_score() {
+  auto& arr = records();
+  float sum = 0;
+  for (size_t i = 0; i < arr.size(); i++) {
+    sum += arr[i].score;
+  }
+  mrt::doNotOptimize(sum);
+}
+
+void soa_sum_score() {
+  auto scores = columns().column<1>();
+  float sum = 0;
+  for (size_t i = 0; i < scores.size(); i++) {
+    sum += scores[i];
+  }
+  mrt::doNotOptimize(sum);
+}
+
+void aos_count_matches() {
+  auto& arr = records();
+  size_t count = 0;
+  for (size_t i = 0; i < arr.size(); i++) {
+    count += arr[i].score > 500 && (arr[i].id & 1);
+  }
+  mrt::doNotOptimize(count);
+}
+
+void soa_count_matches() {
+  auto ids = columns().column<0>();
+  auto scores = columns().column<1>();
+  size_t count = 0;
+  for (size_t i = 0; i < scores.size(); i++) {
+    count += scores[i] > 500 && (ids[i] & 1);
+  }
+  mrt::doNotOptimize(count);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("soa_array");
+
+  records();
+  columns();
+
+  framework.addBenchmarks({
+    {"aos_sum_score", aos_sum_score},
+    {"soa_sum_score", soa_sum_score},
+    {"aos_count_matches", aos_count_matches},
+    {"soa_count_matches", soa_count_matches},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,152 @@
+#include "bench.h"
+#include <mrt/sort/merge.h>
+#include <mrt/sort/radix.h>
+#include <mrt/sort/parallel_merge.h>
+#include <mrt/sort/quick.h>
+#include <mrt/thread_pool.h>
+#include <mrt/array.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+constexpr size_t COUNT = 1 << 20;
+
+struct Record {
+  uint32_t id;
+  uint32_t payload;
+};
+
+template <typename T>
+mrt::Array<T> shuffled() {
+  mrt::Array<T> arr = mrt::Array<T>::empty(COUNT + 1);
+  for (size_t i = 0; i < COUNT; i++) {
+    arr.append((T) (uint32_t) (i * 2654435761u));
+  }
+  return arr;
+}
+
+template <typename T>
+void std_sort() {
+  mrt::Array<T> arr = shuffled<T>();
+  std::sort(arr.data(), arr.data() + arr.size());
+  mrt::doNotOptimize(arr[0]);
+}
+
+template <typename T, typename S>
+void sort() {
+  mrt::Array<T> arr = shuffled<T>();
+  arr.template sort<S>();
+  mrt::doNotOptimize(arr[0]);
+}
+
+// Keys below 2^16, the two upper byte passes are skipped
+void radix_sort_narrow() {
+  mrt::Array<uint32_t> arr = mrt::Array<uint32_t>::empty(COUNT + 1);
+  for (size_t i = 0; i < COUNT; i++) {
+    arr.append((uint32_t) (i * 2654435761u) >> 16);
+  }
+  arr.sort<mrt::RadixSort>();
+  mrt::doNotOptimize(arr[0]);
+}
+
+void merge_sort_records() {
+  mrt::Array<Record> arr = mrt::Array<Record>::empty(COUNT + 1);
+  for (size_t i = 0; i < COUNT; i++) {
+    arr.append(Record{(uint32_t) (i * 2654435761u), (uint32_t) i});
+  }
+  arr.sort([](Record& lhs, Record& rhs) { return lhs.id < rhs.id; });
+  mrt::doNotOptimize(arr[0]);
+}
+
+void radix_sort_records() {
+  mrt::Array<Record> arr = mrt::Array<Record>::empty(COUNT + 1);
+  for (size_t i = 0; i < COUNT; i++) {
+    arr.append(Record{(uint32_t) (i * 2654435761u), (uint32_t) i});
+  }
+  mrt::RadixSort().sort([](const Record& record) { return record.id; }, arr);
+  mrt::doNotOptimize(arr[0]);
+}
+
+enum class Distribution { Random, Sorted, Reversed, OrganPipe, FewUnique };
+
+mrt::Array<uint32_t> distributed(Distribution distribution) {
+  mrt::Array<uint32_t> arr = mrt::Array<uint32_t>::empty(COUNT + 1);
+  for (uint32_t i = 0; i < COUNT; i++) {
+    uint32_t random = i * 2654435761u;
+    switch (distribution) {
+      case Distribution::Random: arr.append(random); break;
+      case Distribution::Sorted: arr.append(i); break;
+      case Distribution::Reversed: arr.append(COUNT - i); break;
+      case Distribution::OrganPipe: arr.append(i < COUNT / 2 ? i : COUNT - i); break;
+      case Distribution::FewUnique: arr.append(random % 16); break;
+    }
+  }
+  return arr;
+}
+
+template <Distribution D, typename S>
+void sort_distribution() {
+  mrt::Array<uint32_t> arr = distributed(D);
+  arr.template sort<S>();
+  mrt::doNotOptimize(arr[0]);
+}
+
+// Comparator that is not a function object of the element type, the scalar partition loop
+void quick_sort_records() {
+  mrt::Array<Record> arr = mrt::Array<Record>::empty(COUNT + 1);
+  for (size_t i = 0; i < COUNT; i++) {
+    arr.append(Record{(uint32_t) (i * 2654435761u), (uint32_t) i});
+  }
+  arr.sort([](Record& lhs, Record& rhs) { return lhs.id < rhs.id; }, mrt::QuickSort());
+  mrt::doNotOptimize(arr[0]);
+}
+
+void parallel_merge_sort(mrt::ThreadPool& pool) {
+  mrt::Array<uint32_t> arr = shuffled<uint32_t>();
+  arr.sort(mrt::Ascending<uint32_t>(), mrt::ParallelMergeSort(0, mrt::ParallelMergeSort::DEFAULT_CUTOFF, pool));
+  mrt::doNotOptimize(arr[0]);
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("sort");
+
+  framework.addBenchmarks({
+    {"std_sort_u32", std_sort<uint32_t>},
+    {"merge_sort_u32", sort<uint32_t, mrt::MergeSort>},
+    {"radix_sort_u32", sort<uint32_t, mrt::RadixSort>},
+    {"radix_sort_u32_narrow", radix_sort_narrow},
+    {"std_sort_f64", std_sort<double>},
+    {"merge_sort_f64", sort<double, mrt::MergeSort>},
+    {"radix_sort_f64", sort<double, mrt::RadixSort>},
+    {"merge_sort_records", merge_sort_records},
+    {"radix_sort_records", radix_sort_records},
+    {"quick_sort_records", quick_sort_records},
+    {"merge_sort_random", sort_distribution<Distribution::Random, mrt::MergeSort>},
+    {"quick_sort_random", sort_distribution<Distribution::Random, mrt::QuickSort>},
+    {"merge_sort_sorted", sort_distribution<Distribution::Sorted, mrt::MergeSort>},
+    {"quick_sort_sorted", sort_distribution<Distribution::Sorted, mrt::QuickSort>},
+    {"merge_sort_reversed", sort_distribution<Distribution::Reversed, mrt::MergeSort>},
+    {"quick_sort_reversed", sort_distribution<Distribution::Reversed, mrt::QuickSort>},
+    {"merge_sort_organ_pipe", sort_distribution<Distribution::OrganPipe, mrt::MergeSort>},
+    {"quick_sort_organ_pipe", sort_distribution<Distribution::OrganPipe, mrt::QuickSort>},
+    {"merge_sort_few_unique", sort_distribution<Distribution::FewUnique, mrt::MergeSort>},
+    {"quick_sort_few_unique", sort_distribution<Distribution::FewUnique, mrt::QuickSort>},
+  });
+
+  // 1, 2, 4, ... threads, up to and including the number of hardware threads
+  std::vector<std::unique_ptr<mrt::ThreadPool>> pools;
+  for (size_t threads = 1; ; threads *= 2) {
+    if (threads > mrt::ThreadPool::defaultThreads()) threads = mrt::ThreadPool::defaultThreads();
+    pools.push_back(std::make_unique<mrt::ThreadPool>(threads));
+    if (threads == mrt::ThreadPool::defaultThreads()) break;
+  }
+
+  for (auto& pool : pools) {
+    mrt::ThreadPool* p = pool.get();
+    framework.addBenchmark("parallel_merge_sort_u32_" + std::to_string(p->threads()), [p]() { parallel_merge_sort(*p); });
+  }
+
+  return framework.run(argc, argv);
+}
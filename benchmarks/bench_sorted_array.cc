@@ -0,0 +1,92 @@
+#include "bench.h"
+#include <mrt/sorted_array.h>
+#include <mrt/array.h>
+#include <cstdint>
+
+constexpr size_t COUNT = 1 << 20;
+constexpr size_t LOOKUPS = 1 << 20;
+constexpr size_t LINEAR_LOOKUPS = 1 << 8;
+constexpr size_t BATCH = 1 << 10;
+
+inline uint32_t key(size_t i) {
+  return (uint32_t) (i * 2654435761u);
+}
+
+struct Sorted {
+  mrt::Array<uint32_t> array;
+  mrt::SortedArray<uint32_t> sorted;
+
+  Sorted() {
+    for (size_t i = 0; i < COUNT; i++) {
+      array.append(key(i));
+    }
+    sorted.insertMany(array);
+    array = mrt::Array<uint32_t>(sorted.view());
+  }
+};
+
+Sorted& sorted() {
+  static Sorted instance;
+  return instance;
+}
+
+void array_contains() {
+  auto& arr = sorted().array;
+  size_t found = 0;
+  for (size_t i = 0; i < LINEAR_LOOKUPS; i++) {
+    found += arr.contains(key(i * 3));
+  }
+  mrt::doNotOptimize(found);
+}
+
+// Branching binary search of ArrayView, mispredicts about every other step on random keys
+void array_binary_search() {
+  auto& arr = sorted().array;
+  size_t found = 0;
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    found += arr.binarySearch(key(i * 3)) != mrt::nidx;
+  }
+  mrt::doNotOptimize(found);
+}
+
+void sorted_array_contains() {
+  auto& arr = sorted().sorted;
+  size_t found = 0;
+  for (size_t i = 0; i < LOOKUPS; i++) {
+    found += arr.contains(key(i * 3));
+  }
+  mrt::doNotOptimize(found);
+}
+
+// BATCH new keys into a copy of the COUNT element array
+void sorted_array_insert() {
+  mrt::SortedArray<uint32_t> arr = sorted().sorted;
+  for (size_t i = 0; i < BATCH; i++) {
+    arr.insert(key(COUNT + i));
+  }
+  mrt::doNotOptimize(arr.size());
+}
+
+void sorted_array_insert_many() {
+  mrt::SortedArray<uint32_t> arr = sorted().sorted;
+  mrt::Array<uint32_t> batch;
+  for (size_t i = 0; i < BATCH; i++) {
+    batch.append(key(COUNT + i));
+  }
+  arr.insertMany(batch);
+  mrt::doNotOptimize(arr.size());
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("sorted_array");
+
+  framework.addBenchmarks({
+    {"array_contains_256", array_contains},
+    {"array_binary_search", array_binary_search},
+    {"sorted_array_contains", sorted_array_contains},
+    {"sorted_array_insert", sorted_array_insert},
+    {"sorted_array_insert_many", sorted_array_insert_many},
+  });
+
+  return framework.run(argc, argv);
+}
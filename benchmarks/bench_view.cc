@@ -0,0 +1,64 @@
+#include "bench.h"
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <mrt/view.h>
+#include <cstdint>
+
+constexpr uint32_t COUNT = 1 << 22;
+constexpr uint32_t LIST_COUNT = 1 << 20;
+
+template <typename C>
+C& filled(uint32_t count) {
+  static C c;
+  if (!c.size()) {
+    for (uint32_t i = 0; i < count; i++) {
+      c.append(i * 2654435761u);
+    }
+  }
+  return c;
+}
+
+// Every stage materializes a full intermediate collection
+template <typename C>
+void eager(uint32_t count) {
+  uint64_t sum = filled<C>(count)
+    .filter([](const uint32_t& x) { return (x & 3) == 0; })
+    .template map<uint64_t>([](const uint32_t& x) { return (uint64_t) x * 3; })
+    .template reduce<uint64_t>([](uint64_t s, const uint64_t& x) { return s + x; });
+  mrt::doNotOptimize(sum);
+}
+
+template <typename C>
+void lazy(uint32_t count) {
+  uint64_t sum = filled<C>(count).view()
+    .filter([](const uint32_t& x) { return (x & 3) == 0; })
+    .map([](const uint32_t& x) { return (uint64_t) x * 3; })
+    .template reduce<uint64_t>([](uint64_t s, const uint64_t& x) { return s + x; });
+  mrt::doNotOptimize(sum);
+}
+
+// take() lets the lazy pipeline stop early, the eager one still processes everything
+template <typename C, bool Lazy>
+void firstMatches(uint32_t count) {
+  C& c = filled<C>(count);
+  if constexpr (Lazy) {
+    mrt::doNotOptimize(c.view().filter([](const uint32_t& x) { return x % 7 == 0; }).take(100).collect().size());
+  } else {
+    mrt::doNotOptimize(c.filter([](const uint32_t& x) { return x % 7 == 0; }).slice(100).size());
+  }
+}
+
+int main(int argc, char ** argv) {
+  mrt::BenchmarkFramework framework("view");
+
+  framework.addBenchmarks({
+    {"array_eager", []() { eager<mrt::Array<uint32_t>>(COUNT); }},
+    {"array_view", []() { lazy<mrt::Array<uint32_t>>(COUNT); }},
+    {"list_eager", []() { eager<mrt::List<uint32_t>>(LIST_COUNT); }},
+    {"list_view", []() { lazy<mrt::List<uint32_t>>(LIST_COUNT); }},
+    {"array_first_matches_eager", []() { firstMatches<mrt::Array<uint32_t>, false>(COUNT); }},
+    {"array_first_matches_view", []() { firstMatches<mrt::Array<uint32_t>, true>(COUNT); }},
+  });
+
+  return framework.run(argc, argv);
+}
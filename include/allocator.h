@@ -0,0 +1,160 @@
+#ifndef _MRT_COLLECTIONS_ALLOCATOR_H_
+#define _MRT_COLLECTIONS_ALLOCATOR_H_ 1
+
+#include <concepts>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace mrt {
+
+/*
+  Allocators hand out untyped memory, so one allocator instance can serve
+  element buffers, list nodes and map nodes alike.
+  deallocate() gets the size and alignment the memory was allocated with.
+*/
+template <typename A>
+concept Allocator = std::copy_constructible<A> and requires (A a, const A& b, void* p, size_t size, size_t alignment) {
+  { a.allocate(size, alignment) } -> std::same_as<void*>;
+  a.deallocate(p, size, alignment);
+  { a == b } -> std::same_as<bool>;
+};
+
+// Global operator new/delete, the aligned overloads for over-aligned requests
+struct DefaultAllocator {
+  inline void* allocate(size_t size, size_t alignment) {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator new(size, std::align_val_t(alignment));
+    }
+    return ::operator new(size);
+  }
+
+  inline void deallocate(void* ptr, size_t size, size_t alignment) {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(ptr, std::align_val_t(alignment));
+    } else {
+      ::operator delete(ptr);
+    }
+  }
+
+  inline bool operator==(const DefaultAllocator&) const { return true; }
+  inline bool operator!=(const DefaultAllocator&) const { return false; }
+};
+
+/*
+  Bump-pointer region. Memory is taken from geometrically growing blocks and
+  is only returned all at once, by release() or on destruction.
+*/
+class MonotonicArena {
+ public:
+  constexpr static size_t INITIAL_BLOCK_SIZE = 4096;
+  constexpr static size_t GROWTH_FACTOR = 2;
+
+ public:
+  inline MonotonicArena(size_t blockSize = INITIAL_BLOCK_SIZE) : m_nextBlockSize(blockSize ? blockSize : INITIAL_BLOCK_SIZE) {}
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  inline ~MonotonicArena() {
+    release();
+  }
+
+  inline void* allocate(size_t size, size_t alignment) {
+    uintptr_t start = align((uintptr_t) m_current, alignment);
+    if (!m_current || start + size > (uintptr_t) m_end) {
+      addBlock(size + alignment);
+      start = align((uintptr_t) m_current, alignment);
+    }
+    m_current = (char*) (start + size);
+    m_allocated += size;
+    return (void*) start;
+  }
+
+  inline void deallocate(void* ptr, size_t size, size_t alignment) {}
+
+  // Frees every block, all memory handed out by this arena becomes invalid
+  inline void release() {
+    while (m_blocks) {
+      Block* next = m_blocks->next;
+      ::operator delete(m_blocks);
+      m_blocks = next;
+    }
+    m_current = nullptr;
+    m_end = nullptr;
+    m_allocated = 0;
+    m_reserved = 0;
+  }
+
+  // Like release(), but keeps the largest block so the arena can be refilled without allocating
+  inline void reset() {
+    if (!m_blocks) return;
+    Block* next = m_blocks->next;
+    while (next) {
+      Block* tmp = next->next;
+      ::operator delete(next);
+      next = tmp;
+    }
+    m_blocks->next = nullptr;
+    m_current = (char*) (m_blocks + 1);
+    m_reserved = m_end - (char*) m_blocks;
+    m_allocated = 0;
+  }
+
+  inline size_t allocated() const { return m_allocated; }
+  inline size_t reserved() const { return m_reserved; }
+
+ private:
+  struct Block {
+    Block* next;
+  };
+
+  inline static uintptr_t align(uintptr_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(uintptr_t) (alignment - 1);
+  }
+
+  inline void addBlock(size_t minSize) {
+    size_t size = m_nextBlockSize;
+    while (size < minSize + sizeof(Block)) size *= GROWTH_FACTOR;
+    m_nextBlockSize = size * GROWTH_FACTOR;
+
+    Block* block = static_cast<Block*>(::operator new(size));
+    block->next = m_blocks;
+    m_blocks = block;
+    m_current = (char*) (block + 1);
+    m_end = (char*) block + size;
+    m_reserved += size;
+  }
+
+ private:
+  Block* m_blocks = nullptr;
+  char* m_current = nullptr;
+  char* m_end = nullptr;
+  size_t m_nextBlockSize;
+  size_t m_allocated = 0;
+  size_t m_reserved = 0;
+};
+
+// Handle to a MonotonicArena, arena has to outlive every collection using it
+class ArenaAllocator {
+ public:
+  inline ArenaAllocator(MonotonicArena& arena) : m_arena(&arena) {}
+
+  inline void* allocate(size_t size, size_t alignment) {
+    return m_arena->allocate(size, alignment);
+  }
+
+  inline void deallocate(void* ptr, size_t size, size_t alignment) {}
+
+  inline MonotonicArena& arena() const { return *m_arena; }
+
+  inline bool operator==(const ArenaAllocator& rhs) const { return m_arena == rhs.m_arena; }
+  inline bool operator!=(const ArenaAllocator& rhs) const { return m_arena != rhs.m_arena; }
+
+ private:
+  MonotonicArena* m_arena;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_ALLOCATOR_H_ */
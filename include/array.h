@@ -2,17 +2,36 @@
 #define _MRT_COLLECTIONS_ARRAY_H_ 1
 
 #include <initializer_list>
+#include <type_traits>
 #include <functional>
 #include <concepts>
+#include <utility>
+#include <memory>
+#include <cstring>
 #include <cstdlib>
+#include <new>
 #include <mrt/utils/constants.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/simd.h>
+#include <mrt/utils/hash_set.h>
+#include <mrt/utils/mapped_file.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
+#include <mrt/thread_pool.h>
+#include <mrt/array_view.h>
+#include <mrt/cow.h>
 #include <mrt/sort/merge.h>
 #include <mrt/sort.h>
 
 namespace mrt {
 
-template <typename T>
+// G decides how capacity grows once INITIAL_SIZE is exceeded, see utils/memory.h
+template <typename T, Allocator A = DefaultAllocator, GrowthPolicy G = DoublingGrowth>
 class Array {
+  // parallelMap() constructs elements of Array<R, A> in place
+  template <typename, Allocator, GrowthPolicy>
+  friend class Array;
+
  public:
   class Iterator {
    public:
@@ -203,18 +222,36 @@ class Array {
   };
 
   constexpr static size_t INITIAL_SIZE = 8;
-  constexpr static size_t GROWTH_FACTOR = 2;
+  constexpr static size_t PARALLEL_CHUNK_BYTES = 64 * 1024;
 
  public:
   inline Array() {
     reserve(INITIAL_SIZE);
   }
 
-  inline Array(const Array& rhs) {
+  inline Array(const A& allocator) : m_allocator(allocator) {
+    reserve(INITIAL_SIZE);
+  }
+
+  inline Array(const Array& rhs) : m_allocator(rhs.m_allocator) {
     operator=(rhs);
   }
 
-  inline Array(std::initializer_list<T> il) {
+  /*
+    Not noexcept: elements of rhs in a derived container's storage (SmallArray) are moved to a new
+    buffer, which can throw. Heap buffers change hands without allocating.
+  */
+  inline Array(Array&& rhs) : m_allocator(rhs.m_allocator) {
+    take(rhs);
+  }
+
+  // Copies viewed elements, explicit so comparing or appending a view never allocates silently
+  inline explicit Array(ArrayView<T> view, const A& allocator = A()) : m_allocator(allocator) {
+    reserve(view.size() + 1);
+    operator+=(view);
+  }
+
+  inline Array(std::initializer_list<T> il, const A& allocator = A()) : m_allocator(allocator) {
     reserve(il.size());
     for (auto x : il) {
       append(x);
@@ -225,14 +262,14 @@ class Array {
     clear();
   }
 
-  static inline Array empty(size_t size) {
-    Array result;
+  static inline Array empty(size_t size, const A& allocator = A()) {
+    Array result(allocator);
     result.reserve(size);
     return result;
   }
 
-  static inline Array filled(size_t size, T element) {
-    Array result;
+  static inline Array filled(size_t size, T element, const A& allocator = A()) {
+    Array result(allocator);
     result.reserve(size);
     for (size_t i = 0; i < size; i++) {
       result.append(element);
@@ -242,7 +279,21 @@ class Array {
 
   inline size_t size() const { return m_size; }
   inline size_t capacity() const { return m_capacity; }
+
+  // Bytes held from the allocator, an inline buffer (SmallArray) isn't counted
+  inline size_t memoryUsage() const {
+    return m_buffer && !isInStorage() ? m_capacity * sizeof(T) : 0;
+  }
+
+  inline MemoryStats stats() const {
+    MemoryStats result;
+    result.allocated = memoryUsage();
+    result.live = m_size * sizeof(T);
+    result.reallocations = m_reallocations;
+    return result;
+  }
   inline T* data() const { return m_buffer; }
+  inline const A& allocator() const { return m_allocator; }
 
   inline Iterator begin() { return Iterator(this, 0); }
   inline Iterator end() { return Iterator(this, m_size); }
@@ -250,38 +301,57 @@ class Array {
   inline ConstIterator cbegin() const { return ConstIterator(this, 0); }
   inline ConstIterator cend() const { return ConstIterator(this, m_size); }
 
-  inline void append(const T& element) {
+  template <typename... Args>
+  inline T& emplace(Args&&... args) {
     if (m_size + 1 >= m_capacity) {
-      reserve(m_capacity * GROWTH_FACTOR);
+      // args may reference an element of this array, so build the value before relocating
+      T value(std::forward<Args>(args)...);
+      grow();
+      return construct(std::move(value));
     }
-    m_buffer[m_size++] = element;
+    return construct(std::forward<Args>(args)...);
+  }
+
+  inline void append(const T& element) {
+    emplace(element);
   }
-  
+
+  /*
+    Adds count slots at the end and returns the first one, for bulk fills (memcpy, read())
+    of trivially copyable elements. Slots hold indeterminate values until written.
+  */
+  inline T* appendUninitialized(size_t count) requires std::is_trivially_copyable_v<T> {
+    growFor(count);
+    T* start = m_buffer + m_size;
+    m_size += count;
+    return start;
+  }
+
+  inline void append(T&& element) {
+    emplace(std::move(element));
+  }
+
   inline void prepend(const T& element) {
-    if (m_size + 1 >= m_capacity) {
-      reserve(m_capacity * GROWTH_FACTOR);
-    }
-    for (int i = m_size; i > 0; i--) {
-      m_buffer[i] = m_buffer[i-1];
-    }
-    m_buffer[0] = element;
-    m_size++;
+    emplaceAt(0, element);
+  }
+
+  inline void prepend(T&& element) {
+    emplaceAt(0, std::move(element));
   }
 
   inline T pop() {
     m_size--;
-    return std::move(m_buffer[m_size]);
+    T value = std::move(m_buffer[m_size]);
+    m_buffer[m_size].~T();
+    return value;
   }
 
   inline void insert(size_t index, const T& element) {
-    if (m_size + 1 >= m_capacity) {
-      reserve(m_capacity * GROWTH_FACTOR);
-    }
-    for (size_t i = m_size; i > index; i--) {
-      m_buffer[i] = m_buffer[i-1];
-    }
-    m_buffer[index] = element;
-    m_size++;
+    emplaceAt(index, element);
+  }
+
+  inline void insert(size_t index, T&& element) {
+    emplaceAt(index, std::move(element));
   }
 
   inline void insert(const Iterator& it, const T& element) {
@@ -289,17 +359,20 @@ class Array {
   }
 
   inline void remove(size_t index) {
-    for (size_t i = index; i < m_size; i++) {
-      m_buffer[i] = m_buffer[i+1];
-    }
-    m_size--;
+    remove(index, index + 1);
   }
 
   inline void remove(size_t start, size_t end) {
-    for (size_t i = start; i < m_size; i++) {
-      m_buffer[i] = m_buffer[i + end - start];
+    size_t count = end - start;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memmove(m_buffer + start, m_buffer + end, (m_size - end) * sizeof(T));
+    } else {
+      for (size_t i = start; i + count < m_size; i++) {
+        m_buffer[i] = std::move(m_buffer[i + count]);
+      }
+      destroy(m_size - count, m_size);
     }
-    m_size -= end - start;
+    m_size -= count;
   }
 
   inline void remove(const Iterator& it) {
@@ -313,98 +386,108 @@ class Array {
   inline void reserve(size_t size) {
     if (m_buffer) {
       if (size > m_capacity) {
-        T* buffer = m_buffer;
-        m_buffer = new T[size];
-        for (size_t i = 0; i < m_size; i++) {
-          m_buffer[i] = buffer[i];
-        }
-        delete [] buffer;
+        T* buffer = allocate(size);
+        relocate(buffer, m_buffer, m_size);
+        deallocate(m_buffer, m_capacity);
+        m_buffer = buffer;
         m_capacity = size;
+        m_reallocations++;
       }
     } else {
       m_capacity = size;
       m_size = 0;
-      m_buffer = new T[size];
+      m_buffer = allocate(size);
     }
   }
 
+  // Frees the buffer, an array with initial storage (SmallArray) goes back to it
   inline void clear() {
     if (m_buffer) {
-      delete [] m_buffer;
+      destroy(0, m_size);
+      deallocate(m_buffer, m_capacity);
       m_size = 0;
-      m_capacity = 0;
-      m_buffer = nullptr;
+      resetBuffer();
     }
   }
 
   inline bool contains(const T& value) const {
-    for (size_t i = 0; i < m_size; i++) {
-      if (m_buffer[i] == value) {
-        return true;
-      }
-    }
+    return view().contains(value);
+  }
 
-    return false;
+  // Non-owning view of elements [start, end), see ArrayView
+  inline ArrayView<T> view(size_t start = 0, size_t end = nidx) const {
+    return ArrayView<T>(m_buffer, m_size).slice(start, end);
   }
 
   inline Array slice(size_t start, size_t end = 0) const {
-    Array result;
+    return end == 0 ? Array(view(0, start), m_allocator) : Array(view(start, end), m_allocator);
+  }
 
-    if (end == 0) {
-      for (size_t i = 0; i < start; i++) {
-        result.append(m_buffer[i]);
-      }
-    } else {
-      for (size_t i = start; i < end; i++) {
-        result.append(m_buffer[i]);
-      }
-    }
+  inline Array<size_t, A> find(const T& value, size_t startIdx = 0) const {
+    return view().find(value, startIdx, m_allocator);
+  }
 
-    return result;
+  inline size_t lfind(const T& value, size_t startIdx = 0) const {
+    return view().lfind(value, startIdx);
   }
 
-  inline Array<size_t> find(const T& value, size_t startIdx = 0) const {
-    Array<size_t> indexes;
+  // Searches backwards from startIdx (inclusive), or from the last element if startIdx is 0
+  inline size_t rfind(const T& value, size_t startIdx = 0) const {
+    return view().rfind(value, startIdx);
+  }
 
-    for (size_t i = startIdx; i < m_size; i++) {
-      if (m_buffer[i] == value) {
-        indexes.append(i);
-      }
-    }
+  // Array has to be sorted ascending, see ArrayView::binarySearch
+  inline size_t binarySearch(const T& value) const requires Ordered<T> {
+    return view().binarySearch(value);
+  }
 
-    return indexes;
+  // Writes elements to a file that MappedArray can map, see utils/mapped_file.h
+  inline void save(const char* path) const requires Mappable<T> {
+    mapped::save(path, m_buffer, m_size);
   }
 
-  inline size_t lfind(const T& value, size_t startIdx = 0) const {
-    for (size_t i = startIdx; i < m_size; i++) {
-      if (m_buffer[i] == value) {
-        return i;
+  // Keeps first occurrence of every value, in order
+  inline Array unique() const {
+    Array result(m_allocator);
+
+    if constexpr (Ordered<T>) {
+      if (isSorted()) {
+        // Duplicates of a sorted array are adjacent
+        for (size_t i = 0; i < m_size; i++) {
+          if (!i || !(m_buffer[i] == m_buffer[i-1])) {
+            result.append(m_buffer[i]);
+          }
+        }
+        return result;
       }
     }
 
-    return nidx;
-  }
-
-  inline size_t rfind(const T& value, size_t startIdx = 0) const {
-    for (size_t i = (startIdx ? startIdx : m_size-1); i >= 0; i--) {
-      if (m_buffer[i] == value) {
-        return i;
+    if constexpr (HashKey<T>) {
+      HashSet<T, A> seen(m_size, m_allocator);
+      for (size_t i = 0; i < m_size; i++) {
+        if (seen.insert(m_buffer[i])) {
+          result.append(m_buffer[i]);
+        }
+      }
+    } else {
+      for (size_t i = 0; i < m_size; i++) {
+        if (!result.contains(m_buffer[i])) {
+          result.append(m_buffer[i]);
+        }
       }
     }
 
-    return nidx;
+    return result;
   }
 
-  inline Array unique() {
-    Array result;
-
-    for (size_t i = 0; i < m_size; i++) {
-      if (!result.contains(m_buffer[i])) {
-        result.append(m_buffer[i]);
+  // Ascending by operator<, checked in one pass that stops at the first inversion
+  inline bool isSorted() const requires Ordered<T> {
+    for (size_t i = 1; i < m_size; i++) {
+      if (m_buffer[i] < m_buffer[i-1]) {
+        return false;
       }
     }
-
-    return result;
+    return true;
   }
 
   inline void reverse() {
@@ -412,7 +495,7 @@ class Array {
   }
 
   inline Array reversed() {
-    Array result;
+    Array result(m_allocator);
 
     for (size_t i = m_size; i > 0; i--) {
       result.append(m_buffer[i-1]);
@@ -421,13 +504,13 @@ class Array {
     return result;
   }
 
-  template <Sorter<T, Array> S = MergeSort>
-  inline void sort(SortComparator<T> comparator = asc<T>, S sorter = {}) {
+  template <Sorter<T, Array> S = MergeSort, Comparator<T> F = Ascending<T>>
+  inline void sort(F comparator = {}, S sorter = {}) {
     sorter.sort(comparator, *this);
   }
 
-  template <Sorter<T, Array> S = MergeSort>
-  inline Array sorted(SortComparator<T> comparator = asc<T>, S sorter = {}) {
+  template <Sorter<T, Array> S = MergeSort, Comparator<T> F = Ascending<T>>
+  inline Array sorted(F comparator = {}, S sorter = {}) {
     Array result = *this;
 
     sorter.sort(comparator, result);
@@ -435,14 +518,16 @@ class Array {
     return result;
   }
 
-  inline void foreach(std::function<void(const T&)> f) const {
+  template <Consumer<const T&> F>
+  inline void foreach(F f) const {
     for (size_t i = 0; i < m_size; i++) {
       f(m_buffer[i]);
     }
   }
 
-  inline Array filter(std::function<bool(const T&)> pred) const {
-    Array result;
+  template <Predicate<const T&> F>
+  inline Array filter(F pred) const {
+    Array result(m_allocator);
     result.reserve(size());
     for (size_t i = 0; i < m_size; i++) {
       if (pred(m_buffer[i])) {
@@ -452,8 +537,8 @@ class Array {
     return result;
   }
 
-  template <typename R = T>
-  inline R reduce(std::function<R(R, const T&)> reducer, R startValue = {}) const {
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduce(F reducer, R startValue = {}) const {
     R result = startValue;
     for (size_t i = 0; i < m_size; i++) {
       result = reducer(result, m_buffer[i]);
@@ -461,8 +546,8 @@ class Array {
     return result;
   }
 
-  template <typename R = T>
-  inline R reduceRight(std::function<R(R, const T&)> reducer, R startValue = {}) const {
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduceRight(F reducer, R startValue = {}) const {
     R result = startValue;
     for (size_t i = m_size; i > 0; i--) {
       result = reducer(result, m_buffer[i-1]);
@@ -470,15 +555,93 @@ class Array {
     return result;
   }
 
-  template <typename R = T>
-  inline Array<R> map(std::function<R(const T&)> mapper) const {
-    Array<R> result;
+  template <typename R = T, Callable<R, const T&> F>
+  inline Array<R, A> map(F mapper) const {
+    Array<R, A> result(m_allocator);
     for (size_t i = 0; i < m_size; i++) {
       result.append(mapper(m_buffer[i]));
     }
     return result;
   }
 
+  // Like map(), but chunks of the array are mapped on pool's threads
+  template <typename R = T, Callable<R, const T&> F>
+  inline Array<R, A> parallelMap(F mapper, ThreadPool& pool = ThreadPool::global()) const {
+    size_t chunkSize = parallelChunkSize(pool);
+    Array<size_t> offsets = Array<size_t>::empty(chunkCount(chunkSize) + 1);
+    for (size_t i = 0; i < m_size; i += chunkSize) {
+      offsets.append(i);
+    }
+    offsets.append(m_size);
+
+    Array<R, A> result(m_allocator);
+    result.reserve(m_size);
+    parallelConstruct(result, offsets, chunkSize, pool, [this, &mapper](size_t begin, size_t end, R*& out) {
+      for (size_t i = begin; i < end; i++) {
+        new (out) R(mapper(m_buffer[i]));
+        out++;
+      }
+    });
+    return result;
+  }
+
+  // Like filter(), but predicate runs on pool's threads. Result keeps the original order
+  template <Predicate<const T&> F>
+  inline Array parallelFilter(F pred, ThreadPool& pool = ThreadPool::global()) const {
+    size_t chunkSize = parallelChunkSize(pool);
+    std::unique_ptr<bool[]> keep(new bool[m_size]);
+    Array<size_t> offsets = Array<size_t>::filled(chunkCount(chunkSize) + 1, 0);
+
+    // First pass counts kept elements per chunk, prefix sums of the counts are where each chunk's output starts
+    pool.parallelFor(m_size, chunkSize, [this, &pred, &keep, &offsets, chunkSize](size_t begin, size_t end) {
+      size_t kept = 0;
+      for (size_t i = begin; i < end; i++) {
+        keep[i] = pred(m_buffer[i]);
+        kept += keep[i];
+      }
+      offsets[begin / chunkSize + 1] = kept;
+    });
+    for (size_t i = 1; i < offsets.size(); i++) {
+      offsets[i] += offsets[i-1];
+    }
+
+    Array result(m_allocator);
+    result.reserve(offsets[offsets.size() - 1]);
+    parallelConstruct(result, offsets, chunkSize, pool, [this, &keep](size_t begin, size_t end, T*& out) {
+      for (size_t i = begin; i < end; i++) {
+        if (keep[i]) {
+          new (out) T(m_buffer[i]);
+          out++;
+        }
+      }
+    });
+    return result;
+  }
+
+  /*
+    Every chunk is reduced from startValue on pool's threads, then partial results are combined in order.
+    combiner has to be associative and startValue has to be its identity.
+  */
+  template <typename R = T, Callable<R, R, const T&> F, Callable<R, R, R> C>
+  inline R parallelReduce(F reducer, C combiner, R startValue = {}, ThreadPool& pool = ThreadPool::global()) const {
+    size_t chunkSize = parallelChunkSize(pool);
+    Array<R> partials = Array<R>::filled(chunkCount(chunkSize), startValue);
+
+    pool.parallelFor(m_size, chunkSize, [this, &reducer, &partials, &startValue, chunkSize](size_t begin, size_t end) {
+      R result = startValue;
+      for (size_t i = begin; i < end; i++) {
+        result = reducer(result, m_buffer[i]);
+      }
+      partials[begin / chunkSize] = std::move(result);
+    });
+
+    R result = startValue;
+    for (size_t i = 0; i < partials.size(); i++) {
+      result = combiner(result, partials[i]);
+    }
+    return result;
+  }
+
   inline T& get(size_t index, T defaultValue) {
     if (index < 0) return (m_size - index >= 0) ? m_buffer[m_size - index] : defaultValue;
     return (index < m_size) ? m_buffer[index] : defaultValue;
@@ -500,6 +663,7 @@ class Array {
   }
 
   inline Array& operator=(const Array& rhs) {
+    if (this == &rhs) return *this;
     clear();
     reserve(rhs.m_capacity);
     for (size_t i = 0; i < rhs.m_size; i++) {
@@ -508,6 +672,23 @@ class Array {
     return *this;
   }
 
+  // Allocates, and so can throw, like the move constructor, and also when allocators differ
+  inline Array& operator=(Array&& rhs) {
+    if (this == &rhs) return *this;
+    clear();
+    if (m_allocator == rhs.m_allocator) {
+      take(rhs);
+    } else {
+      // Buffer can't change hands between allocators, elements are moved instead
+      reserve(rhs.m_capacity);
+      for (size_t i = 0; i < rhs.m_size; i++) {
+        append(std::move(rhs.m_buffer[i]));
+      }
+      rhs.clear();
+    }
+    return *this;
+  }
+
   inline bool operator==(const Array& rhs) const {
     if (m_size != rhs.m_size) return false;
     if (m_buffer == rhs.m_buffer) return true;
@@ -521,6 +702,14 @@ class Array {
     return true;
   }
 
+  inline bool operator==(ArrayView<T> rhs) const {
+    return view() == rhs;
+  }
+
+  inline bool operator!=(ArrayView<T> rhs) const {
+    return view() != rhs;
+  }
+
   inline bool operator!=(const Array& rhs) const {
     if (m_size != rhs.m_size) return true;
     if (m_buffer == rhs.m_buffer) return false;
@@ -551,41 +740,242 @@ class Array {
     return *this;
   }
 
+  inline Array& operator+=(ArrayView<T> rhs) {
+    // rhs may view this array, so it's re-pointed after the buffer moves
+    bool aliased = rhs.data() >= m_buffer && rhs.data() < m_buffer + m_size;
+    size_t offset = aliased ? rhs.data() - m_buffer : 0;
+    growFor(rhs.size());
+    if (aliased) rhs = ArrayView<T>(m_buffer + offset, rhs.size());
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (rhs.size()) std::memcpy(m_buffer + m_size, rhs.data(), rhs.size() * sizeof(T));
+      m_size += rhs.size();
+    } else {
+      for (size_t i = 0; i < rhs.size(); i++) {
+        append(rhs[i]);
+      }
+    }
+    return *this;
+  }
+
   inline Array& operator+=(const T& rhs) {
     append(rhs);
     return *this;
   }
 
+  // Elements that are also in rhs
   inline Array operator&(const Array& rhs) const {
-    Array result;
+    return select(rhs, true);
+  }
 
-    for (size_t i = 0; i < m_size; i++) {
-      if (rhs.contains(m_buffer[i])) {
-        result.append(m_buffer[i]);
+  // Elements that are not in rhs
+  inline Array operator|(const Array& rhs) const {
+    return select(rhs, false);
+  }
+
+ protected:
+  // For derived containers that provide initial storage themselves (see SmallArray).
+  // Storage is never freed by Array, growing past capacity moves elements to the heap.
+  inline Array(T* storage, size_t capacity, const A& allocator = A())
+    : m_capacity(capacity), m_buffer(storage), m_storage(storage), m_storageCapacity(capacity), m_allocator(allocator) {}
+
+  inline bool isInStorage() const {
+    return m_buffer && m_buffer == m_storage;
+  }
+
+ private:
+  // Storage is raw memory aligned for T, slots in [m_size, m_capacity) hold no live object
+  inline T* allocate(size_t size) {
+    return static_cast<T*>(m_allocator.allocate(size * sizeof(T), alignof(T)));
+  }
+
+  inline void deallocate(T* buffer, size_t capacity) {
+    if (buffer != m_storage) {
+      m_allocator.deallocate(buffer, capacity * sizeof(T), alignof(T));
+    }
+  }
+
+  inline void resetBuffer() {
+    m_buffer = m_storage;
+    m_capacity = m_storage ? m_storageCapacity : 0;
+  }
+
+  // Moves count elements from src into uninitialized dest, leaving src uninitialized
+  inline static void relocate(T* dest, T* src, size_t count) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (count) std::memcpy(dest, src, count * sizeof(T));
+    } else {
+      for (size_t i = 0; i < count; i++) {
+        new (dest + i) T(std::move(src[i]));
+        src[i].~T();
       }
     }
+  }
 
-    return result;
+  inline void destroy(size_t start, size_t end) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = start; i < end; i++) {
+        m_buffer[i].~T();
+      }
+    }
   }
 
-  inline Array operator|(const Array& rhs) const {
-    Array result;
+  inline void take(Array& rhs) {
+    if (rhs.isInStorage()) {
+      // Buffer is owned by rhs itself, so elements have to be moved out one by one
+      reserve(rhs.m_capacity);
+      relocate(m_buffer, rhs.m_buffer, rhs.m_size);
+      m_size = rhs.m_size;
+      rhs.m_size = 0;
+      return;
+    }
+    m_size = rhs.m_size;
+    m_capacity = rhs.m_capacity;
+    m_buffer = rhs.m_buffer;
+    m_reallocations = rhs.m_reallocations;
+    rhs.m_size = 0;
+    rhs.resetBuffer();
+    rhs.m_reallocations = 0;
+  }
+
+  // Keeps elements whose presence in rhs equals present, in order
+  inline Array select(const Array& rhs, bool present) const {
+    Array result(m_allocator);
+
+    if constexpr (Ordered<T>) {
+      if (isSorted() && rhs.isSorted()) {
+        // Both sorted: single merge-like pass, j is the first element of rhs not less than m_buffer[i]
+        for (size_t i = 0, j = 0; i < m_size; i++) {
+          while (j < rhs.m_size && rhs.m_buffer[j] < m_buffer[i]) j++;
+          if ((j < rhs.m_size && rhs.m_buffer[j] == m_buffer[i]) == present) {
+            result.append(m_buffer[i]);
+          }
+        }
+        return result;
+      }
+    }
 
-    for (size_t i = 0; i < m_size; i++) {
-      if (!rhs.contains(m_buffer[i])) {
-        result.append(m_buffer[i]);
+    if constexpr (HashKey<T>) {
+      HashSet<T, A> set(rhs.m_size, m_allocator);
+      for (size_t i = 0; i < rhs.m_size; i++) {
+        set.insert(rhs.m_buffer[i]);
+      }
+      for (size_t i = 0; i < m_size; i++) {
+        if (set.contains(m_buffer[i]) == present) {
+          result.append(m_buffer[i]);
+        }
+      }
+    } else {
+      for (size_t i = 0; i < m_size; i++) {
+        if (rhs.contains(m_buffer[i]) == present) {
+          result.append(m_buffer[i]);
+        }
       }
     }
 
     return result;
   }
 
+  // Chunks hold at most PARALLEL_CHUNK_BYTES of elements, smaller arrays are still split between all threads
+  inline size_t parallelChunkSize(const ThreadPool& pool) const {
+    size_t chunkSize = sizeof(T) < PARALLEL_CHUNK_BYTES ? PARALLEL_CHUNK_BYTES / sizeof(T) : 1;
+    size_t perThread = (m_size + pool.threads() - 1) / pool.threads();
+    if (perThread < chunkSize) chunkSize = perThread;
+    return chunkSize ? chunkSize : 1;
+  }
+
+  inline size_t chunkCount(size_t chunkSize) const {
+    return (m_size + chunkSize - 1) / chunkSize;
+  }
+
+  /*
+    Fills result's uninitialized storage in parallel, chunk i constructs elements [offsets[i], offsets[i+1]).
+    If a chunk throws, elements of every other chunk are destroyed before the exception is rethrown.
+  */
+  template <typename R, typename F>
+  inline void parallelConstruct(Array<R, A>& result, const Array<size_t>& offsets, size_t chunkSize, ThreadPool& pool, F construct) const {
+    size_t chunks = offsets.size() - 1;
+    std::unique_ptr<bool[]> built(new bool[chunks]());
+
+    try {
+      pool.parallelFor(m_size, chunkSize, [&result, &offsets, &built, &construct, chunkSize](size_t begin, size_t end) {
+        size_t chunk = begin / chunkSize;
+        R* start = result.m_buffer + offsets[chunk];
+        R* out = start;
+        try {
+          construct(begin, end, out);
+        } catch (...) {
+          for (R* p = start; p != out; p++) {
+            p->~R();
+          }
+          throw;
+        }
+        built[chunk] = true;
+      });
+    } catch (...) {
+      for (size_t i = 0; i < chunks; i++) {
+        if (built[i]) result.destroy(offsets[i], offsets[i+1]);
+      }
+      throw;
+    }
+
+    result.m_size = offsets[chunks];
+  }
+
+  inline void grow() {
+    reserve(m_capacity ? G::grow(m_capacity, m_size + 2) : INITIAL_SIZE);
+  }
+
+  // Size only grows once the element is built, a throwing constructor leaves the array unchanged
+  template <typename... Args>
+  inline T& construct(Args&&... args) {
+    T* element = new (m_buffer + m_size) T(std::forward<Args>(args)...);
+    m_size++;
+    return *element;
+  }
+
+  // Makes room for count more elements, geometrically so repeated bulk appends stay amortized O(1)
+  inline void growFor(size_t count) {
+    if (m_size + count + 1 > m_capacity) {
+      reserve(G::grow(m_capacity, m_size + count + 1));
+    }
+  }
+
+  template <typename... Args>
+  inline T& emplaceAt(size_t index, Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    if (m_size + 1 >= m_capacity) {
+      grow();
+    }
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memmove(m_buffer + index + 1, m_buffer + index, (m_size - index) * sizeof(T));
+      new (m_buffer + index) T(std::move(value));
+    } else if (index == m_size) {
+      new (m_buffer + index) T(std::move(value));
+    } else {
+      new (m_buffer + m_size) T(std::move(m_buffer[m_size - 1]));
+      for (size_t i = m_size - 1; i > index; i--) {
+        m_buffer[i] = std::move(m_buffer[i-1]);
+      }
+      m_buffer[index] = std::move(value);
+    }
+    m_size++;
+    return m_buffer[index];
+  }
+
  private:
   size_t m_size = 0;
   size_t m_capacity = 0;
   T* m_buffer = nullptr;
+  T* m_storage = nullptr;
+  size_t m_storageCapacity = 0;
+  size_t m_reallocations = 0;
+  [[no_unique_address]] A m_allocator;
 };
 
+// Array whose copies share elements until one of them is mutated, see Cow
+template <typename T, Allocator A = DefaultAllocator, GrowthPolicy G = DoublingGrowth>
+using CowArray = Cow<Array<T, A, G>, A>;
+
 } /* namespace mrt */
 
 #endif /* _MRT_COLLECTIONS_ARRAY_H_ */
\ No newline at end of file
@@ -0,0 +1,210 @@
+#ifndef _MRT_COLLECTIONS_ARRAY_VIEW_H_
+#define _MRT_COLLECTIONS_ARRAY_VIEW_H_ 1
+
+#include <concepts>
+#include <cstdlib>
+#include <mrt/utils/constants.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/simd.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
+#include <mrt/view.h>
+
+namespace mrt {
+
+template <typename T, Allocator A, GrowthPolicy G>
+class Array;
+
+/*
+  Non-owning read-only window into contiguous elements (pointer + length), cheap to copy and pass by value.
+  Elements belong to the viewed Array, any operation that reallocates it invalidates the view.
+  filter() and map() start a lazy View, take(), skip() and slice() return narrower ArrayViews.
+*/
+template <typename T>
+class ArrayView {
+ public:
+  inline ArrayView() {}
+  inline ArrayView(const T* data, size_t size) : m_data(data), m_size(size) {}
+
+  template <Allocator A, GrowthPolicy G>
+  inline ArrayView(const Array<T, A, G>& array) : m_data(array.data()), m_size(array.size()) {}
+
+  inline size_t size() const { return m_size; }
+  inline const T* data() const { return m_data; }
+
+  inline const T* begin() const { return m_data; }
+  inline const T* end() const { return m_data + m_size; }
+
+  inline const T* cbegin() const { return m_data; }
+  inline const T* cend() const { return m_data + m_size; }
+
+  inline const T& operator[](size_t index) const {
+    return m_data[index];
+  }
+
+  // Elements [start, end), both are clamped to the view
+  inline ArrayView slice(size_t start, size_t end = nidx) const {
+    if (end > m_size) end = m_size;
+    if (start > end) start = end;
+    return ArrayView(m_data + start, end - start);
+  }
+
+  inline ArrayView take(size_t count) const {
+    return slice(0, count);
+  }
+
+  inline ArrayView skip(size_t count) const {
+    return slice(count);
+  }
+
+  inline bool contains(const T& value) const {
+    return lfind(value) != nidx;
+  }
+
+  inline size_t lfind(const T& value, size_t startIdx = 0) const {
+    if (startIdx >= m_size) return nidx;
+
+    if constexpr (SimdSearchable<T>) {
+      size_t index = simd::find(m_data + startIdx, m_size - startIdx, value);
+      return index == nidx ? nidx : startIdx + index;
+    }
+
+    for (size_t i = startIdx; i < m_size; i++) {
+      if (m_data[i] == value) {
+        return i;
+      }
+    }
+
+    return nidx;
+  }
+
+  // Searches backwards from startIdx (inclusive), or from the last element if startIdx is 0
+  inline size_t rfind(const T& value, size_t startIdx = 0) const {
+    size_t end = (startIdx && startIdx < m_size) ? startIdx + 1 : m_size;
+
+    if constexpr (SimdSearchable<T>) {
+      return simd::rfind(m_data, end, value);
+    }
+
+    for (size_t i = end; i > 0; i--) {
+      if (m_data[i-1] == value) {
+        return i-1;
+      }
+    }
+
+    return nidx;
+  }
+
+  template <Allocator A = DefaultAllocator>
+  inline Array<size_t, A, DoublingGrowth> find(const T& value, size_t startIdx = 0, const A& allocator = A()) const {
+    Array<size_t, A, DoublingGrowth> indexes(allocator);
+    if (startIdx >= m_size) return indexes;
+
+    if constexpr (SimdSearchable<T>) {
+      simd::findAll(m_data + startIdx, m_size - startIdx, value, [&indexes, startIdx](size_t i) { indexes.append(startIdx + i); });
+      return indexes;
+    }
+
+    for (size_t i = startIdx; i < m_size; i++) {
+      if (m_data[i] == value) {
+        indexes.append(i);
+      }
+    }
+
+    return indexes;
+  }
+
+  // Index of the first element not less than value, elements have to be sorted ascending
+  inline size_t lowerBound(const T& value) const requires Ordered<T> {
+    size_t low = 0, high = m_size;
+    while (low < high) {
+      size_t mid = low + (high - low) / 2;
+      if (m_data[mid] < value) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  // Index of an element equal to value in a sorted view, or nidx
+  inline size_t binarySearch(const T& value) const requires Ordered<T> {
+    size_t index = lowerBound(value);
+    return index < m_size && !(value < m_data[index]) ? index : nidx;
+  }
+
+  template <Consumer<const T&> F>
+  inline void foreach(F f) const {
+    for (size_t i = 0; i < m_size; i++) {
+      f(m_data[i]);
+    }
+  }
+
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduce(F reducer, R startValue = {}) const {
+    R result = startValue;
+    for (size_t i = 0; i < m_size; i++) {
+      result = reducer(result, m_data[i]);
+    }
+    return result;
+  }
+
+  template <Predicate<const T&> F>
+  inline auto filter(F pred) const {
+    return lazy().filter(pred);
+  }
+
+  template <Consumer<const T&> F>
+  inline auto map(F mapper) const {
+    return lazy().map(mapper);
+  }
+
+  inline size_t count() const {
+    return m_size;
+  }
+
+  // Copies elements into an owning collection, Array by default
+  template <typename C = Array<T, DefaultAllocator, DoublingGrowth>>
+  inline C collect() const {
+    C result;
+    for (size_t i = 0; i < m_size; i++) {
+      result.append(m_data[i]);
+    }
+    return result;
+  }
+
+  inline bool operator==(const ArrayView& rhs) const {
+    if (m_size != rhs.m_size) return false;
+    if (m_data == rhs.m_data) return true;
+
+    for (size_t i = 0; i < m_size; i++) {
+      if (!(m_data[i] == rhs.m_data[i])) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  inline bool operator!=(const ArrayView& rhs) const {
+    return !operator==(rhs);
+  }
+
+ private:
+  inline auto lazy() const {
+    return makeView<T>([data = m_data, size = m_size](auto&& sink) {
+      for (size_t i = 0; i < size; i++) {
+        if (!sink(data[i])) return;
+      }
+    });
+  }
+
+ private:
+  const T* m_data = nullptr;
+  size_t m_size = 0;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_ARRAY_VIEW_H_ */
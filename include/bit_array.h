@@ -0,0 +1,369 @@
+#ifndef _MRT_COLLECTIONS_BIT_ARRAY_H_
+#define _MRT_COLLECTIONS_BIT_ARRAY_H_ 1
+
+#include <initializer_list>
+#include <exception>
+#include <cstdint>
+#include <cstdlib>
+#include <bit>
+#include <mrt/utils/constants.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/memory.h>
+#include <mrt/array_view.h>
+#include <mrt/array.h>
+
+namespace mrt {
+
+/*
+  Array of flags packed 64 per word. Counting, searching and bitwise operators work a word at a time,
+  the plain word loops are left for the compiler to vectorize.
+  Bits past size() in the last word are always zero, so whole words can be compared and counted.
+*/
+class BitArray {
+ public:
+  struct MismatchedSizesException : public std::exception {
+    inline MismatchedSizesException() {}
+  };
+
+  using Word = uint64_t;
+
+  constexpr static size_t WORD_BITS = 64;
+
+  class ConstIterator {
+   public:
+    inline ConstIterator(const BitArray* array, size_t index) : m_array(array), m_index(index) {}
+
+    inline size_t index() const { return m_index; }
+
+    inline bool operator*() const { return m_array->get(m_index); }
+
+    inline bool operator==(const ConstIterator& rhs) const { return m_index == rhs.m_index; }
+    inline bool operator!=(const ConstIterator& rhs) const { return m_index != rhs.m_index; }
+
+    inline ConstIterator& operator++() {
+      m_index++;
+      return *this;
+    }
+
+    inline ConstIterator operator++(int) {
+      ConstIterator it = *this;
+      m_index++;
+      return it;
+    }
+
+   private:
+    const BitArray* m_array;
+    size_t m_index;
+  };
+
+ public:
+  inline BitArray() {}
+
+  inline explicit BitArray(size_t size, bool value = false) {
+    resize(size, value);
+  }
+
+  inline BitArray(std::initializer_list<bool> il) {
+    reserve(il.size());
+    for (bool x : il) {
+      append(x);
+    }
+  }
+
+  inline explicit BitArray(ArrayView<bool> values) {
+    reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      append(values[i]);
+    }
+  }
+
+  BitArray(const BitArray&) = default;
+  BitArray(BitArray&&) = default;
+
+  BitArray& operator=(const BitArray&) = default;
+  BitArray& operator=(BitArray&&) = default;
+
+  inline virtual ~BitArray() {}
+
+  inline size_t size() const { return m_size; }
+  inline size_t capacity() const { return m_words.capacity() * WORD_BITS; }
+
+  inline size_t memoryUsage() const {
+    return m_words.memoryUsage();
+  }
+
+  // Live bytes are the bytes needed for size() bits
+  inline MemoryStats stats() const {
+    MemoryStats result = m_words.stats();
+    result.live = (m_size + 7) / 8;
+    return result;
+  }
+
+  // Packed storage, bit i is bit (i % 64) of word i / 64
+  inline ArrayView<Word> words() const { return m_words.view(); }
+
+  inline ConstIterator begin() const { return ConstIterator(this, 0); }
+  inline ConstIterator end() const { return ConstIterator(this, m_size); }
+
+  inline ConstIterator cbegin() const { return ConstIterator(this, 0); }
+  inline ConstIterator cend() const { return ConstIterator(this, m_size); }
+
+  inline bool get(size_t index) const {
+    return (m_words[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+  }
+
+  inline bool operator[](size_t index) const {
+    return get(index);
+  }
+
+  inline void set(size_t index, bool value = true) {
+    Word mask = (Word) 1 << (index % WORD_BITS);
+    if (value) {
+      m_words[index / WORD_BITS] |= mask;
+    } else {
+      m_words[index / WORD_BITS] &= ~mask;
+    }
+  }
+
+  inline void reset(size_t index) {
+    set(index, false);
+  }
+
+  inline void flip(size_t index) {
+    m_words[index / WORD_BITS] ^= (Word) 1 << (index % WORD_BITS);
+  }
+
+  inline void append(bool value) {
+    if (m_size % WORD_BITS == 0) {
+      m_words.append(0);
+    }
+    m_size++;
+    if (value) set(m_size - 1);
+  }
+
+  inline bool pop() {
+    bool value = get(m_size - 1);
+    reset(m_size - 1);
+    m_size--;
+    if (m_size % WORD_BITS == 0) {
+      m_words.pop();
+    }
+    return value;
+  }
+
+  inline void reserve(size_t size) {
+    m_words.reserve(wordsFor(size) + 1);
+  }
+
+  // New bits are set to value, dropped bits are cleared
+  inline void resize(size_t size, bool value = false) {
+    size_t words = wordsFor(size);
+    if (size > m_size) {
+      reserve(size);
+      if (value && m_size % WORD_BITS) {
+        m_words[m_words.size() - 1] |= ~(Word) 0 << (m_size % WORD_BITS);
+      }
+      while (m_words.size() < words) {
+        m_words.append(value ? ~(Word) 0 : 0);
+      }
+    } else if (words < m_words.size()) {
+      m_words.remove(words, m_words.size());
+    }
+    m_size = size;
+    clearTail();
+  }
+
+  inline void fill(bool value) {
+    for (size_t i = 0; i < m_words.size(); i++) {
+      m_words[i] = value ? ~(Word) 0 : 0;
+    }
+    clearTail();
+  }
+
+  inline void clear() {
+    m_words.clear();
+    m_size = 0;
+  }
+
+  // Number of set bits
+  inline size_t count() const {
+    size_t result = 0;
+    for (size_t i = 0; i < m_words.size(); i++) {
+      result += std::popcount(m_words[i]);
+    }
+    return result;
+  }
+
+  inline bool any() const {
+    for (size_t i = 0; i < m_words.size(); i++) {
+      if (m_words[i]) return true;
+    }
+    return false;
+  }
+
+  inline bool none() const {
+    return !any();
+  }
+
+  inline bool all() const {
+    return count() == m_size;
+  }
+
+  // Index of the first set bit, or nidx
+  inline size_t findFirst() const {
+    return findNext(0);
+  }
+
+  // Index of the first set bit at or after start, or nidx
+  inline size_t findNext(size_t start) const {
+    return lfind(true, start);
+  }
+
+  inline size_t lfind(bool value, size_t startIdx = 0) const {
+    if (startIdx >= m_size) return nidx;
+
+    size_t word = startIdx / WORD_BITS;
+    // Bits before startIdx are masked out of the first word
+    Word bits = (value ? m_words[word] : ~m_words[word]) & (~(Word) 0 << (startIdx % WORD_BITS));
+    while (true) {
+      if (bits) {
+        size_t index = word * WORD_BITS + std::countr_zero(bits);
+        return index < m_size ? index : nidx;
+      }
+      if (++word == m_words.size()) return nidx;
+      bits = value ? m_words[word] : ~m_words[word];
+    }
+  }
+
+  // Searches backwards from startIdx (inclusive), or from the last bit if startIdx is 0
+  inline size_t rfind(bool value, size_t startIdx = 0) const {
+    if (!m_size) return nidx;
+
+    size_t last = (startIdx && startIdx < m_size) ? startIdx : m_size - 1;
+    size_t word = last / WORD_BITS;
+    Word bits = (value ? m_words[word] : ~m_words[word]) & (~(Word) 0 >> (WORD_BITS - 1 - last % WORD_BITS));
+    while (true) {
+      if (bits) {
+        return word * WORD_BITS + WORD_BITS - 1 - std::countl_zero(bits);
+      }
+      if (word-- == 0) return nidx;
+      bits = value ? m_words[word] : ~m_words[word];
+    }
+  }
+
+  inline bool contains(bool value) const {
+    return lfind(value) != nidx;
+  }
+
+  inline Array<size_t> find(bool value, size_t startIdx = 0) const {
+    Array<size_t> indexes;
+    for (size_t i = lfind(value, startIdx); i != nidx; i = lfind(value, i + 1)) {
+      indexes.append(i);
+    }
+    return indexes;
+  }
+
+  template <Consumer<bool> F>
+  inline void foreach(F f) const {
+    for (size_t i = 0; i < m_size; i++) {
+      f(get(i));
+    }
+  }
+
+  // Calls f(index) for every set bit in order, skipping clear words at once
+  template <Consumer<size_t> F>
+  inline void foreachSet(F f) const {
+    for (size_t i = 0; i < m_words.size(); i++) {
+      for (Word bits = m_words[i]; bits; bits &= bits - 1) {
+        f(i * WORD_BITS + std::countr_zero(bits));
+      }
+    }
+  }
+
+  inline Array<bool> toArray() const {
+    Array<bool> result = Array<bool>::empty(m_size + 1);
+    for (size_t i = 0; i < m_size; i++) {
+      result.append(get(i));
+    }
+    return result;
+  }
+
+  inline BitArray& operator&=(const BitArray& rhs) {
+    checkSize(rhs);
+    for (size_t i = 0; i < m_words.size(); i++) {
+      m_words[i] &= rhs.m_words[i];
+    }
+    return *this;
+  }
+
+  inline BitArray& operator|=(const BitArray& rhs) {
+    checkSize(rhs);
+    for (size_t i = 0; i < m_words.size(); i++) {
+      m_words[i] |= rhs.m_words[i];
+    }
+    return *this;
+  }
+
+  inline BitArray& operator^=(const BitArray& rhs) {
+    checkSize(rhs);
+    for (size_t i = 0; i < m_words.size(); i++) {
+      m_words[i] ^= rhs.m_words[i];
+    }
+    return *this;
+  }
+
+  inline BitArray operator&(const BitArray& rhs) const {
+    BitArray result = *this;
+    return result &= rhs;
+  }
+
+  inline BitArray operator|(const BitArray& rhs) const {
+    BitArray result = *this;
+    return result |= rhs;
+  }
+
+  inline BitArray operator^(const BitArray& rhs) const {
+    BitArray result = *this;
+    return result ^= rhs;
+  }
+
+  inline BitArray operator~() const {
+    BitArray result = *this;
+    for (size_t i = 0; i < result.m_words.size(); i++) {
+      result.m_words[i] = ~result.m_words[i];
+    }
+    result.clearTail();
+    return result;
+  }
+
+  inline bool operator==(const BitArray& rhs) const {
+    return m_size == rhs.m_size && m_words == rhs.m_words;
+  }
+
+  inline bool operator!=(const BitArray& rhs) const {
+    return !operator==(rhs);
+  }
+
+ private:
+  inline static size_t wordsFor(size_t bits) {
+    return (bits + WORD_BITS - 1) / WORD_BITS;
+  }
+
+  inline void clearTail() {
+    if (m_size % WORD_BITS) {
+      m_words[m_words.size() - 1] &= ~(Word) 0 >> (WORD_BITS - m_size % WORD_BITS);
+    }
+  }
+
+  inline void checkSize(const BitArray& rhs) const {
+    if (m_size != rhs.m_size) throw MismatchedSizesException();
+  }
+
+ private:
+  Array<Word> m_words;
+  size_t m_size = 0;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_BIT_ARRAY_H_ */
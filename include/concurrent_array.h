@@ -0,0 +1,302 @@
+#ifndef _MRT_COLLECTIONS_CONCURRENT_ARRAY_H_
+#define _MRT_COLLECTIONS_CONCURRENT_ARRAY_H_ 1
+
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <bit>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
+#include <mrt/array.h>
+#include <mrt/view.h>
+
+namespace mrt {
+
+/*
+  Append-only array for many concurrent producers. append() claims a slot with a compare-and-swap on one counter,
+  storage grows by segments of doubling size (like SegmentedArray), so elements are never moved
+  and a new segment is the only point where producers can meet. Each segment is allocated by one
+  producer, the one claiming the first slot of the segment before it, so it is usually ready
+  before anyone reaches it.
+  Readers see a published prefix: size() only covers elements whose construction has finished,
+  every element before it included, so [0, size()) can be read while appends go on.
+  clear(), copying and destruction need exclusive access.
+*/
+template <typename T, Allocator A = DefaultAllocator>
+class ConcurrentArray {
+  static_assert(std::is_nothrow_move_constructible_v<T>, "ConcurrentArray elements have to be nothrow move constructible");
+
+ public:
+  constexpr static size_t CACHE_LINE_SIZE = 64;
+  constexpr static size_t FIRST_BITS = 4;
+  constexpr static size_t FIRST_SEGMENT = (size_t) 1 << FIRST_BITS;
+  constexpr static size_t MAX_SEGMENTS = sizeof(size_t) * 8 - FIRST_BITS;
+  constexpr static size_t WAIT_YIELDS = 1 << 10;
+
+ public:
+  inline ConcurrentArray() {}
+
+  inline ConcurrentArray(const A& allocator) : m_allocator(allocator) {}
+
+  inline ConcurrentArray(std::initializer_list<T> il, const A& allocator = A()) : m_allocator(allocator) {
+    for (auto& x : il) {
+      append(x);
+    }
+  }
+
+  inline ConcurrentArray(const ConcurrentArray& rhs) : m_allocator(rhs.m_allocator) {
+    rhs.foreach([this](const T& value) { append(value); });
+  }
+
+  ConcurrentArray& operator=(const ConcurrentArray&) = delete;
+
+  inline virtual ~ConcurrentArray() {
+    clear();
+  }
+
+  inline const A& allocator() const { return m_allocator; }
+
+  // Published elements, all of them can be read
+  inline size_t size() const { return m_size.value.load(std::memory_order_acquire); }
+
+  inline size_t capacity() const {
+    size_t k = 0;
+    while (k < MAX_SEGMENTS && m_segments[k].load(std::memory_order_acquire)) k++;
+    return capacityOf(k);
+  }
+
+  /*
+    Safe from any number of threads, returns the element's index.
+    A claimed slot has to be filled or later elements would never be published, so a value whose
+    constructor may throw is built before claiming and then moved in.
+  */
+  template <typename... Args>
+  inline size_t emplace(Args&&... args) {
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+      return claim([&args...](T* slot) { new (slot) T(std::forward<Args>(args)...); });
+    } else {
+      T value(std::forward<Args>(args)...);
+      return claim([&value](T* slot) { new (slot) T(std::move(value)); });
+    }
+  }
+
+  inline size_t append(const T& element) {
+    return emplace(element);
+  }
+
+  inline size_t append(T&& element) {
+    return emplace(std::move(element));
+  }
+
+  // Elements past size() may still be under construction
+  inline const T& operator[](size_t index) const {
+    size_t k = segmentOf(index);
+    return elements(m_segments[k].load(std::memory_order_acquire))[offsetOf(index, k)];
+  }
+
+  inline const T& get(size_t index, const T& defaultValue) const {
+    return index < size() ? (*this)[index] : defaultValue;
+  }
+
+  // Visits the elements published when the call started, a segment at a time
+  template <Consumer<const T&> F>
+  inline void foreach(F f) const {
+    size_t count = size();
+    for (size_t k = 0; capacityOf(k) < count; k++) {
+      const T* segment = elements(m_segments[k].load(std::memory_order_acquire));
+      size_t end = count - capacityOf(k) < segmentSize(k) ? count - capacityOf(k) : segmentSize(k);
+      for (size_t i = 0; i < end; i++) {
+        f(segment[i]);
+      }
+    }
+  }
+
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduce(F reducer, R startValue = {}) const {
+    R result = startValue;
+    foreach([&result, &reducer](const T& value) { result = reducer(result, value); });
+    return result;
+  }
+
+  // Copy of the published elements, in index order
+  inline Array<T, A> snapshot() const {
+    Array<T, A> result = Array<T, A>::empty(size() + 1, m_allocator);
+    foreach([&result](const T& value) { result.append(value); });
+    return result;
+  }
+
+  // Lazy single-pass pipeline over the published elements, see View
+  inline auto view() const {
+    return makeView<T>([this](auto&& sink) {
+      size_t count = size();
+      for (size_t i = 0; i < count; i++) {
+        if (!sink((*this)[i])) return;
+      }
+    });
+  }
+
+  inline size_t memoryUsage() const {
+    return capacity() * (sizeof(T) + 1);
+  }
+
+  inline MemoryStats stats() const {
+    MemoryStats result;
+    result.allocated = memoryUsage();
+    result.live = size() * sizeof(T);
+    return result;
+  }
+
+  // Not thread-safe
+  inline void clear() {
+    size_t count = m_claimed.value.load(std::memory_order_acquire);
+    for (size_t k = 0; k < MAX_SEGMENTS; k++) {
+      char* segment = m_segments[k].load(std::memory_order_acquire);
+      if (!segment) break;
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        size_t end = count > capacityOf(k) ? count - capacityOf(k) : 0;
+        for (size_t i = 0; i < end && i < segmentSize(k); i++) {
+          elements(segment)[i].~T();
+        }
+      }
+      m_allocator.deallocate(segment, segmentBytes(k), alignof(T));
+      m_segments[k].store(nullptr, std::memory_order_relaxed);
+    }
+    m_claimed.value.store(0, std::memory_order_relaxed);
+    m_size.value.store(0, std::memory_order_release);
+  }
+
+ private:
+  // Keeps the two hot counters on separate cache lines
+  struct alignas(CACHE_LINE_SIZE) Counter {
+    std::atomic<size_t> value = 0;
+  };
+
+  using Flag = std::atomic<uint8_t>;
+
+  inline static size_t segmentSize(size_t k) {
+    return FIRST_SEGMENT << k;
+  }
+
+  inline static size_t capacityOf(size_t k) {
+    return (FIRST_SEGMENT << k) - FIRST_SEGMENT;
+  }
+
+  inline static size_t segmentOf(size_t index) {
+    return std::bit_width(index + FIRST_SEGMENT) - 1 - FIRST_BITS;
+  }
+
+  inline static size_t offsetOf(size_t index, size_t segment) {
+    return index - capacityOf(segment);
+  }
+
+  // Elements first, then one ready flag per element
+  inline static size_t segmentBytes(size_t k) {
+    return segmentSize(k) * (sizeof(T) + sizeof(Flag));
+  }
+
+  inline static T* elements(char* segment) {
+    return reinterpret_cast<T*>(segment);
+  }
+
+  inline static const T* elements(const char* segment) {
+    return reinterpret_cast<const T*>(segment);
+  }
+
+  inline static Flag* flags(char* segment, size_t k) {
+    return reinterpret_cast<Flag*>(segment + segmentSize(k) * sizeof(T));
+  }
+
+  /*
+    A slot is only claimed once its segment is in place, so running out of memory throws before
+    anything is claimed and publication never waits on a slot that can't be filled.
+  */
+  template <typename F>
+  inline size_t claim(F construct) {
+    size_t index = m_claimed.value.load(std::memory_order_relaxed);
+    size_t k, offset;
+    char* segment;
+    do {
+      k = segmentOf(index);
+      offset = offsetOf(index, k);
+      segment = segmentFor(k);
+    } while (!m_claimed.value.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+    if (offset == 0 && k + 1 < MAX_SEGMENTS && !m_segments[k + 1].load(std::memory_order_acquire)) {
+      try {
+        install(k + 1);
+      } catch (...) {
+        // Whoever reaches segment k + 1 first installs it, before claiming
+      }
+    }
+
+    construct(elements(segment) + offset);
+    size_t expected = index;
+    if (m_size.value.compare_exchange_strong(expected, index + 1, std::memory_order_seq_cst)) {
+      // Every earlier element is published, this one goes out without its flag
+      publish(index + 1);
+    } else {
+      flags(segment, k)[offset].store(1, std::memory_order_seq_cst);
+      publish(m_size.value.load(std::memory_order_seq_cst));
+    }
+    return index;
+  }
+
+  /*
+    Claiming the first slot of segment k - 1 makes a producer the installer of k. Anyone else waits
+    for it, and only installs k itself after WAIT_YIELDS, so an installer that is descheduled or
+    failed to allocate doesn't stall the others for good. Segment 0 has no installer ahead of it,
+    the first producers race for it.
+  */
+  inline char* install(size_t k) {
+    char* segment = nullptr;
+    char* allocated = static_cast<char*>(m_allocator.allocate(segmentBytes(k), alignof(T)));
+    Flag* ready = flags(allocated, k);
+    for (size_t i = 0; i < segmentSize(k); i++) {
+      new (ready + i) Flag(0);
+    }
+    if (m_segments[k].compare_exchange_strong(segment, allocated, std::memory_order_acq_rel)) {
+      return allocated;
+    }
+    m_allocator.deallocate(allocated, segmentBytes(k), alignof(T));
+    return segment;
+  }
+
+  inline char* segmentFor(size_t k) {
+    char* segment = m_segments[k].load(std::memory_order_acquire);
+    for (size_t i = 0; !segment && k > 0 && i < WAIT_YIELDS; i++) {
+      std::this_thread::yield();
+      segment = m_segments[k].load(std::memory_order_acquire);
+    }
+    return segment ? segment : install(k);
+  }
+
+  /*
+    Moves size() from count over every consecutive ready element. A producer that can't publish its own
+    element right away marks its slot ready, then helps. Both steps are seq_cst: either the producer
+    sees size() reach its slot and advances it itself, or the producer that moved size() there sees the slot ready.
+  */
+  inline void publish(size_t count) {
+    while (count < m_claimed.value.load(std::memory_order_seq_cst)) {
+      size_t k = segmentOf(count);
+      char* segment = m_segments[k].load(std::memory_order_acquire);
+      if (!segment || !flags(segment, k)[offsetOf(count, k)].load(std::memory_order_seq_cst)) return;
+      if (m_size.value.compare_exchange_weak(count, count + 1, std::memory_order_seq_cst)) count++;
+    }
+  }
+
+ private:
+  Counter m_claimed;
+  Counter m_size;
+  std::atomic<char*> m_segments[MAX_SEGMENTS] = {};
+  [[no_unique_address]] A m_allocator;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_CONCURRENT_ARRAY_H_ */
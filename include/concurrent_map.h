@@ -0,0 +1,186 @@
+#ifndef _MRT_COLLECTIONS_CONCURRENT_MAP_H_
+#define _MRT_COLLECTIONS_CONCURRENT_MAP_H_ 1
+
+#include <initializer_list>
+#include <shared_mutex>
+#include <mutex>
+#include <cstdlib>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/hash.h>
+#include <mrt/utils/memory.h>
+#include <mrt/flat_map.h>
+#include <mrt/array.h>
+#include <mrt/pair.h>
+
+namespace mrt {
+
+/*
+  Thread-safe hash map. Keys are split across Shards independently locked FlatMaps,
+  so threads only contend when they touch the same shard. Readers of a shard share its lock.
+  Values are returned by copy, references into a shard would outlive its lock.
+*/
+template <typename K, typename V, size_t Shards = 16>
+class ConcurrentMap {
+  static_assert(Shards > 0, "ConcurrentMap needs at least one shard");
+
+ public:
+  using NoSuchElementException = typename FlatMap<K, V>::NoSuchElementException;
+
+  constexpr static size_t CACHE_LINE_SIZE = 64;
+
+ public:
+  inline ConcurrentMap() {}
+
+  inline ConcurrentMap(std::initializer_list<Pair<K, V>> il) {
+    for (auto& [k, v] : il) {
+      set(k, v);
+    }
+  }
+
+  ConcurrentMap(const ConcurrentMap&) = delete;
+  ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+
+  inline virtual ~ConcurrentMap() {}
+
+  constexpr static size_t shards() {
+    return Shards;
+  }
+
+  inline size_t size() const {
+    size_t result = 0;
+    forEachShard([&result](const FlatMap<K, V>& map) { result += map.size(); });
+    return result;
+  }
+
+  inline size_t memoryUsage() const {
+    size_t result = 0;
+    forEachShard([&result](const FlatMap<K, V>& map) { result += map.memoryUsage(); });
+    return result;
+  }
+
+  inline MemoryStats stats() const {
+    MemoryStats result;
+    forEachShard([&result](const FlatMap<K, V>& map) { result += map.stats(); });
+    return result;
+  }
+
+  inline void clear() {
+    for (auto& shard : m_shards) {
+      std::unique_lock lock(shard.mutex);
+      shard.map.clear();
+    }
+  }
+
+  inline void set(const K& key, const V& value) {
+    Shard& shard = shardFor(key);
+    std::unique_lock lock(shard.mutex);
+    shard.map.set(key, value);
+  }
+
+  inline V get(const K& key) const {
+    const Shard& shard = shardFor(key);
+    std::shared_lock lock(shard.mutex);
+    return shard.map.get(key);
+  }
+
+  inline V get(const K& key, const V& defaultValue) const {
+    const Shard& shard = shardFor(key);
+    std::shared_lock lock(shard.mutex);
+    return shard.map.get(key, defaultValue);
+  }
+
+  inline bool contains(const K& key) const {
+    const Shard& shard = shardFor(key);
+    std::shared_lock lock(shard.mutex);
+    return shard.map.contains(key);
+  }
+
+  // Returns false if key wasn't present, check-then-remove wouldn't be atomic
+  inline bool remove(const K& key) {
+    Shard& shard = shardFor(key);
+    std::unique_lock lock(shard.mutex);
+    if (!shard.map.contains(key)) return false;
+    shard.map.remove(key);
+    return true;
+  }
+
+  // Inserts value if key is missing, otherwise calls updater on the stored value, atomically
+  template <Consumer<V&> F>
+  inline void upsert(const K& key, const V& value, F updater) {
+    Shard& shard = shardFor(key);
+    std::unique_lock lock(shard.mutex);
+    if (shard.map.contains(key)) {
+      updater(shard.map.get(key));
+    } else {
+      shard.map.set(key, value);
+    }
+  }
+
+  // Every shard is read-locked for the whole call, so f observes a single consistent state
+  template <Consumer<const Pair<K, V>&> F>
+  inline void foreach(F f) const {
+    forEachShard([&f](const FlatMap<K, V>& map) { map.foreach(f); });
+  }
+
+  inline Array<K> keys() const {
+    Array<K> result;
+    forEachShard([&result](const FlatMap<K, V>& map) { result += map.keys(); });
+    return result;
+  }
+
+  inline Array<Pair<K, V>> items() const {
+    Array<Pair<K, V>> result;
+    forEachShard([&result](const FlatMap<K, V>& map) { result += map.items(); });
+    return result;
+  }
+
+ private:
+  // Aligned to a cache line, so locking one shard doesn't invalidate its neighbours
+  struct alignas(CACHE_LINE_SIZE) Shard {
+    mutable std::shared_mutex mutex;
+    FlatMap<K, V> map;
+  };
+
+  // FlatMap indexes by the low bits of the same mixed hash, shards are picked by the high ones
+  inline static size_t shardIndex(const K& key) {
+    return (mixHash(getHash(key)) >> 48) % Shards;
+  }
+
+  inline Shard& shardFor(const K& key) {
+    return m_shards[shardIndex(key)];
+  }
+
+  inline const Shard& shardFor(const K& key) const {
+    return m_shards[shardIndex(key)];
+  }
+
+  // Locks are always taken in shard order, so concurrent calls can't deadlock
+  template <typename F>
+  inline void forEachShard(F f) const {
+    for (auto& shard : m_shards) {
+      shard.mutex.lock_shared();
+    }
+    try {
+      for (auto& shard : m_shards) {
+        f(shard.map);
+      }
+    } catch (...) {
+      unlockShared();
+      throw;
+    }
+    unlockShared();
+  }
+
+  inline void unlockShared() const {
+    for (auto& shard : m_shards) {
+      shard.mutex.unlock_shared();
+    }
+  }
+
+ private:
+  Shard m_shards[Shards];
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_CONCURRENT_MAP_H_ */
@@ -0,0 +1,140 @@
+#ifndef _MRT_COLLECTIONS_COW_H_
+#define _MRT_COLLECTIONS_COW_H_ 1
+
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <mrt/allocator.h>
+
+namespace mrt {
+
+/*
+  Copy-on-write handle. Copies share one reference-counted value, mutate() clones it
+  only if another handle still refers to it, so collections can be passed and returned by value cheaply.
+  The reference count is atomic, handles sharing a value can be used from different threads,
+  a single handle needs external synchronization like any other collection.
+  References from get() stay valid until this handle is mutated, reassigned or destroyed,
+  a moved-from handle can only be assigned to or destroyed.
+*/
+template <std::copy_constructible C, Allocator A = DefaultAllocator>
+class Cow {
+  struct Block {
+    template <typename... Args>
+    inline Block(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+    std::atomic<size_t> refs = 1;
+    C value;
+  };
+
+ public:
+  inline Cow(const A& allocator = A()) : m_allocator(allocator) {
+    m_block = create();
+  }
+
+  inline Cow(const C& value, const A& allocator = A()) : m_allocator(allocator) {
+    m_block = create(value);
+  }
+
+  inline Cow(C&& value, const A& allocator = A()) : m_allocator(allocator) {
+    m_block = create(std::move(value));
+  }
+
+  inline Cow(const Cow& rhs) : m_block(rhs.m_block), m_allocator(rhs.m_allocator) {
+    m_block->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  inline Cow(Cow&& rhs) noexcept : m_block(rhs.m_block), m_allocator(rhs.m_allocator) {
+    rhs.m_block = nullptr;
+  }
+
+  inline virtual ~Cow() {
+    release();
+  }
+
+  inline const C& get() const { return m_block->value; }
+
+  inline const C& operator*() const { return m_block->value; }
+  inline const C* operator->() const { return &m_block->value; }
+
+  inline operator const C&() const { return m_block->value; }
+
+  // Number of handles sharing the value
+  inline size_t refs() const { return m_block->refs.load(std::memory_order_acquire); }
+
+  inline bool isShared() const { return refs() > 1; }
+
+  // Value for writing, cloned first if other handles share it
+  inline C& mutate() {
+    if (isShared()) {
+      Block* block = create(m_block->value);
+      release();
+      m_block = block;
+    }
+    return m_block->value;
+  }
+
+  // Moves the value out if this handle is the only one, copies it otherwise, the handle is left moved-from
+  inline C take() && {
+    C value = isShared() ? C(m_block->value) : C(std::move(m_block->value));
+    release();
+    return value;
+  }
+
+  inline Cow& operator=(const Cow& rhs) {
+    if (m_block == rhs.m_block) return *this;
+    rhs.m_block->refs.fetch_add(1, std::memory_order_relaxed);
+    release();
+    m_block = rhs.m_block;
+    m_allocator = rhs.m_allocator;
+    return *this;
+  }
+
+  inline Cow& operator=(Cow&& rhs) noexcept {
+    if (this == &rhs) return *this;
+    release();
+    m_block = rhs.m_block;
+    m_allocator = rhs.m_allocator;
+    rhs.m_block = nullptr;
+    return *this;
+  }
+
+  inline bool operator==(const Cow& rhs) const {
+    return m_block == rhs.m_block || get() == rhs.get();
+  }
+
+  inline bool operator!=(const Cow& rhs) const {
+    return !operator==(rhs);
+  }
+
+ private:
+  template <typename... Args>
+  inline Block* create(Args&&... args) {
+    void* memory = m_allocator.allocate(sizeof(Block), alignof(Block));
+    try {
+      return new (memory) Block(std::forward<Args>(args)...);
+    } catch (...) {
+      m_allocator.deallocate(memory, sizeof(Block), alignof(Block));
+      throw;
+    }
+  }
+
+  // Last handle destroys the value, acq_rel orders every other handle's reads before it
+  inline void release() {
+    if (m_block && m_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      m_block->~Block();
+      m_allocator.deallocate(m_block, sizeof(Block), alignof(Block));
+    }
+    m_block = nullptr;
+  }
+
+ private:
+  Block* m_block = nullptr;
+  [[no_unique_address]] A m_allocator;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_COW_H_ */
@@ -0,0 +1,488 @@
+#ifndef _MRT_COLLECTIONS_DEQUE_H_
+#define _MRT_COLLECTIONS_DEQUE_H_ 1
+
+#include <initializer_list>
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <mrt/utils/constants.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
+#include <mrt/array.h>
+#include <mrt/view.h>
+
+namespace mrt {
+
+/*
+  Double-ended queue on a ring buffer. append, prepend, popFront and popBack are amortized O(1),
+  elements are addressed by index like in Array. Capacity is a power of two, so the physical
+  slot of an element is (head + index) & (capacity - 1). Buffer is allocated on first insert.
+*/
+template <typename T, Allocator A = DefaultAllocator>
+class Deque {
+ public:
+  class Iterator {
+   public:
+    inline Iterator() {}
+    inline Iterator(Deque* deque, size_t index) : m_deque(deque), m_index(index) {}
+
+    Deque& deque() const { return *m_deque; }
+    size_t index() const { return m_index; }
+
+    T& operator*() { return (*m_deque)[m_index]; }
+
+    const T& operator*() const { return (*m_deque)[m_index]; }
+
+    bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index; }
+    bool operator!=(const Iterator& rhs) const { return m_index != rhs.m_index; }
+
+    Iterator& operator++() {
+      m_index++;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator it = *this;
+      m_index++;
+      return it;
+    }
+
+    Iterator& operator--() {
+      m_index--;
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator it = *this;
+      m_index--;
+      return it;
+    }
+
+   private:
+    Deque* m_deque = nullptr;
+    size_t m_index = 0;
+  };
+
+  class ConstIterator {
+   public:
+    inline ConstIterator() {}
+    inline ConstIterator(const Deque* deque, size_t index) : m_deque(deque), m_index(index) {}
+
+    const Deque& deque() const { return *m_deque; }
+    size_t index() const { return m_index; }
+
+    const T& operator*() const { return (*m_deque)[m_index]; }
+
+    bool operator==(const ConstIterator& rhs) const { return m_index == rhs.m_index; }
+    bool operator!=(const ConstIterator& rhs) const { return m_index != rhs.m_index; }
+
+    ConstIterator& operator++() {
+      m_index++;
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator it = *this;
+      m_index++;
+      return it;
+    }
+
+    ConstIterator& operator--() {
+      m_index--;
+      return *this;
+    }
+
+    ConstIterator operator--(int) {
+      ConstIterator it = *this;
+      m_index--;
+      return it;
+    }
+
+   private:
+    const Deque* m_deque = nullptr;
+    size_t m_index = 0;
+  };
+
+  constexpr static size_t INITIAL_SIZE = 8;
+  constexpr static size_t GROWTH_FACTOR = 2;
+
+ public:
+  inline Deque() {}
+
+  inline Deque(const A& allocator) : m_allocator(allocator) {}
+
+  inline Deque(const Deque& rhs) : m_allocator(rhs.m_allocator) {
+    operator=(rhs);
+  }
+
+  inline Deque(Deque&& rhs) noexcept : m_allocator(rhs.m_allocator) {
+    take(rhs);
+  }
+
+  inline Deque(std::initializer_list<T> il, const A& allocator = A()) : m_allocator(allocator) {
+    reserve(il.size());
+    for (auto& x : il) {
+      append(x);
+    }
+  }
+
+  inline virtual ~Deque() {
+    clear();
+  }
+
+  inline size_t size() const { return m_size; }
+  inline size_t capacity() const { return m_capacity; }
+  inline bool isEmpty() const { return m_size == 0; }
+  inline const A& allocator() const { return m_allocator; }
+
+  inline size_t memoryUsage() const {
+    return m_buffer ? m_capacity * sizeof(T) : 0;
+  }
+
+  inline MemoryStats stats() const {
+    MemoryStats result;
+    result.allocated = memoryUsage();
+    result.live = m_size * sizeof(T);
+    result.reallocations = m_reallocations;
+    return result;
+  }
+
+  inline Iterator begin() { return Iterator(this, 0); }
+  inline Iterator end() { return Iterator(this, m_size); }
+
+  inline ConstIterator cbegin() const { return ConstIterator(this, 0); }
+  inline ConstIterator cend() const { return ConstIterator(this, m_size); }
+
+  template <typename... Args>
+  inline T& emplace(Args&&... args) {
+    if (m_size == m_capacity) {
+      // args may reference an element of this deque, so build the value before relocating
+      T value(std::forward<Args>(args)...);
+      grow();
+      return constructBack(std::move(value));
+    }
+    return constructBack(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  inline T& emplaceFront(Args&&... args) {
+    if (m_size == m_capacity) {
+      T value(std::forward<Args>(args)...);
+      grow();
+      return constructFront(std::move(value));
+    }
+    return constructFront(std::forward<Args>(args)...);
+  }
+
+  inline void append(const T& element) {
+    emplace(element);
+  }
+
+  inline void append(T&& element) {
+    emplace(std::move(element));
+  }
+
+  inline void prepend(const T& element) {
+    emplaceFront(element);
+  }
+
+  inline void prepend(T&& element) {
+    emplaceFront(std::move(element));
+  }
+
+  // Same as popBack(), for code written against Array
+  inline T pop() {
+    return popBack();
+  }
+
+  inline T popBack() {
+    T* last = slot(m_size - 1);
+    T value = std::move(*last);
+    last->~T();
+    m_size--;
+    return value;
+  }
+
+  inline T popFront() {
+    T* first = slot(0);
+    T value = std::move(*first);
+    first->~T();
+    m_head = (m_head + 1) & (m_capacity - 1);
+    m_size--;
+    return value;
+  }
+
+  inline T& front() { return *slot(0); }
+  inline const T& front() const { return *slot(0); }
+
+  inline T& back() { return *slot(m_size - 1); }
+  inline const T& back() const { return *slot(m_size - 1); }
+
+  // Rounded up to a power of two
+  inline void reserve(size_t size) {
+    if (size <= m_capacity) return;
+
+    size_t capacity = m_capacity ? m_capacity : INITIAL_SIZE;
+    while (capacity < size) {
+      capacity *= GROWTH_FACTOR;
+    }
+
+    T* buffer = allocate(capacity);
+    if (m_buffer) {
+      // Elements are unwrapped, so the new buffer starts at slot 0
+      size_t first = m_capacity - m_head < m_size ? m_capacity - m_head : m_size;
+      relocate(buffer, m_buffer + m_head, first);
+      relocate(buffer + first, m_buffer, m_size - first);
+      deallocate(m_buffer, m_capacity);
+      m_reallocations++;
+    }
+    m_buffer = buffer;
+    m_capacity = capacity;
+    m_head = 0;
+  }
+
+  inline void clear() {
+    if (m_buffer) {
+      destroy();
+      deallocate(m_buffer, m_capacity);
+      m_size = 0;
+      m_capacity = 0;
+      m_head = 0;
+      m_buffer = nullptr;
+    }
+  }
+
+  inline bool contains(const T& value) const {
+    return lfind(value) != nidx;
+  }
+
+  inline Array<size_t, A> find(const T& value, size_t startIdx = 0) const {
+    Array<size_t, A> indexes(m_allocator);
+    for (size_t i = startIdx; i < m_size; i++) {
+      if ((*this)[i] == value) {
+        indexes.append(i);
+      }
+    }
+    return indexes;
+  }
+
+  inline size_t lfind(const T& value, size_t startIdx = 0) const {
+    for (size_t i = startIdx; i < m_size; i++) {
+      if ((*this)[i] == value) {
+        return i;
+      }
+    }
+    return nidx;
+  }
+
+  // Searches backwards from startIdx (inclusive), or from the last element if startIdx is 0
+  inline size_t rfind(const T& value, size_t startIdx = 0) const {
+    size_t end = (startIdx && startIdx < m_size) ? startIdx + 1 : m_size;
+    for (size_t i = end; i > 0; i--) {
+      if ((*this)[i-1] == value) {
+        return i-1;
+      }
+    }
+    return nidx;
+  }
+
+  // Lazy single-pass pipeline over the elements, front to back, see View
+  inline auto view() const {
+    return makeView<T>([this](auto&& sink) {
+      for (size_t i = 0; i < m_size; i++) {
+        if (!sink((*this)[i])) return;
+      }
+    });
+  }
+
+  template <Consumer<const T&> F>
+  inline void foreach(F f) const {
+    for (size_t i = 0; i < m_size; i++) {
+      f((*this)[i]);
+    }
+  }
+
+  template <Predicate<const T&> F>
+  inline Deque filter(F pred) const {
+    Deque result(m_allocator);
+    for (size_t i = 0; i < m_size; i++) {
+      if (pred((*this)[i])) {
+        result.append((*this)[i]);
+      }
+    }
+    return result;
+  }
+
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduce(F reducer, R startValue = {}) const {
+    R result = startValue;
+    for (size_t i = 0; i < m_size; i++) {
+      result = reducer(result, (*this)[i]);
+    }
+    return result;
+  }
+
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduceRight(F reducer, R startValue = {}) const {
+    R result = startValue;
+    for (size_t i = m_size; i > 0; i--) {
+      result = reducer(result, (*this)[i-1]);
+    }
+    return result;
+  }
+
+  template <typename R = T, Callable<R, const T&> F>
+  inline Deque<R, A> map(F mapper) const {
+    Deque<R, A> result(m_allocator);
+    result.reserve(m_size);
+    for (size_t i = 0; i < m_size; i++) {
+      result.append(mapper((*this)[i]));
+    }
+    return result;
+  }
+
+  inline T& get(size_t index, T& defaultValue) {
+    return index < m_size ? (*this)[index] : defaultValue;
+  }
+
+  inline const T& get(size_t index, const T& defaultValue) const {
+    return index < m_size ? (*this)[index] : defaultValue;
+  }
+
+  inline T& operator[](size_t index) {
+    return *slot(index);
+  }
+
+  inline const T& operator[](size_t index) const {
+    return *slot(index);
+  }
+
+  inline Deque& operator=(const Deque& rhs) {
+    if (this == &rhs) return *this;
+    clear();
+    reserve(rhs.m_size);
+    for (size_t i = 0; i < rhs.m_size; i++) {
+      append(rhs[i]);
+    }
+    return *this;
+  }
+
+  // Allocates, and so can throw, when allocators differ
+  inline Deque& operator=(Deque&& rhs) {
+    if (this == &rhs) return *this;
+    clear();
+    if (m_allocator == rhs.m_allocator) {
+      take(rhs);
+    } else {
+      // Segments can't change hands between allocators, elements are moved instead
+      reserve(rhs.m_size);
+      for (size_t i = 0; i < rhs.m_size; i++) {
+        append(std::move(rhs[i]));
+      }
+      rhs.clear();
+    }
+    return *this;
+  }
+
+  inline bool operator==(const Deque& rhs) const {
+    if (m_size != rhs.m_size) return false;
+    for (size_t i = 0; i < m_size; i++) {
+      if (!((*this)[i] == rhs[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  inline bool operator!=(const Deque& rhs) const {
+    return !operator==(rhs);
+  }
+
+  inline Deque& operator+=(const T& rhs) {
+    append(rhs);
+    return *this;
+  }
+
+ private:
+  inline T* slot(size_t index) const {
+    return m_buffer + ((m_head + index) & (m_capacity - 1));
+  }
+
+  // Size only grows once the element is built, a throwing constructor leaves the deque unchanged
+  template <typename... Args>
+  inline T& constructBack(Args&&... args) {
+    T* element = new (slot(m_size)) T(std::forward<Args>(args)...);
+    m_size++;
+    return *element;
+  }
+
+  template <typename... Args>
+  inline T& constructFront(Args&&... args) {
+    size_t head = (m_head + m_capacity - 1) & (m_capacity - 1);
+    T* element = new (m_buffer + head) T(std::forward<Args>(args)...);
+    m_head = head;
+    m_size++;
+    return *element;
+  }
+
+  inline T* allocate(size_t size) {
+    return static_cast<T*>(m_allocator.allocate(size * sizeof(T), alignof(T)));
+  }
+
+  inline void deallocate(T* buffer, size_t capacity) {
+    m_allocator.deallocate(buffer, capacity * sizeof(T), alignof(T));
+  }
+
+  // Moves count elements from src into uninitialized dest, leaving src uninitialized
+  inline static void relocate(T* dest, T* src, size_t count) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (count) std::memcpy(dest, src, count * sizeof(T));
+    } else {
+      for (size_t i = 0; i < count; i++) {
+        new (dest + i) T(std::move(src[i]));
+        src[i].~T();
+      }
+    }
+  }
+
+  inline void destroy() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = 0; i < m_size; i++) {
+        slot(i)->~T();
+      }
+    }
+  }
+
+  inline void take(Deque& rhs) {
+    m_size = rhs.m_size;
+    m_capacity = rhs.m_capacity;
+    m_head = rhs.m_head;
+    m_buffer = rhs.m_buffer;
+    m_reallocations = rhs.m_reallocations;
+    rhs.m_size = 0;
+    rhs.m_capacity = 0;
+    rhs.m_head = 0;
+    rhs.m_buffer = nullptr;
+    rhs.m_reallocations = 0;
+  }
+
+  inline void grow() {
+    reserve(m_capacity ? m_capacity * GROWTH_FACTOR : INITIAL_SIZE);
+  }
+
+ private:
+  size_t m_size = 0;
+  size_t m_capacity = 0;
+  size_t m_head = 0;
+  T* m_buffer = nullptr;
+  size_t m_reallocations = 0;
+  [[no_unique_address]] A m_allocator;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_DEQUE_H_ */
@@ -0,0 +1,587 @@
+#ifndef _MRT_COLLECTIONS_FLAT_MAP_H_
+#define _MRT_COLLECTIONS_FLAT_MAP_H_ 1
+
+#include <initializer_list>
+#include <functional>
+#include <exception>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/hash.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
+#include <mrt/array.h>
+#include <mrt/view.h>
+#include <mrt/pair.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mrt {
+
+/*
+  Open-addressing hash map in the style of SwissTable.
+  Every slot has a control byte, which is either EMPTY, DELETED or 7 bits of the key's hash.
+  Lookup probes control bytes a group (16 slots) at a time, only slots whose control byte
+  matches are compared, keys and values are stored inline in the slot array.
+*/
+template <typename K, typename V, Allocator A = DefaultAllocator>
+class FlatMap {
+ public:
+  struct NoSuchElementException : public std::exception {
+    inline NoSuchElementException() {}
+  };
+
+  struct MismatchedSizesException : public std::exception {
+    inline MismatchedSizesException() {}
+  };
+
+  class Iterator {
+   public:
+    inline Iterator() {}
+    inline Iterator(const Iterator& rhs) : m_map(rhs.m_map), m_index(rhs.m_index) {}
+    inline Iterator(FlatMap* map, size_t index) : m_map(map), m_index(map->nextFull(index)) {}
+
+    inline virtual ~Iterator() {}
+
+    inline FlatMap* map() const { return m_map; }
+    inline size_t index() const { return m_index; }
+
+    Iterator& operator=(const Iterator& rhs) {
+      m_map = rhs.m_map;
+      m_index = rhs.m_index;
+      return *this;
+    }
+
+    Pair<K, V>& operator*() { return m_map->m_slots[m_index]; }
+
+    bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index; }
+    bool operator!=(const Iterator& rhs) const { return m_index != rhs.m_index; }
+
+    Iterator& operator++() {
+      m_index = m_map->nextFull(m_index + 1);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator it = *this;
+      m_index = m_map->nextFull(m_index + 1);
+      return it;
+    }
+
+   private:
+    FlatMap* m_map = nullptr;
+    size_t m_index = 0;
+  };
+
+  class ConstIterator {
+   public:
+    inline ConstIterator() {}
+    inline ConstIterator(const ConstIterator& rhs) : m_map(rhs.m_map), m_index(rhs.m_index) {}
+    inline ConstIterator(const FlatMap* map, size_t index) : m_map(map), m_index(map->nextFull(index)) {}
+
+    inline virtual ~ConstIterator() {}
+
+    inline const FlatMap* map() const { return m_map; }
+    inline size_t index() const { return m_index; }
+
+    ConstIterator& operator=(const ConstIterator& rhs) {
+      m_map = rhs.m_map;
+      m_index = rhs.m_index;
+      return *this;
+    }
+
+    const Pair<K, V>& operator*() const { return m_map->m_slots[m_index]; }
+
+    bool operator==(const ConstIterator& rhs) const { return m_index == rhs.m_index; }
+    bool operator!=(const ConstIterator& rhs) const { return m_index != rhs.m_index; }
+
+    ConstIterator& operator++() {
+      m_index = m_map->nextFull(m_index + 1);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator it = *this;
+      m_index = m_map->nextFull(m_index + 1);
+      return it;
+    }
+
+   private:
+    const FlatMap* m_map = nullptr;
+    size_t m_index = 0;
+  };
+
+  constexpr static size_t GROUP_SIZE = 16;
+  constexpr static size_t INITIAL_SIZE = 16;
+  constexpr static size_t GROWTH_FACTOR = 2;
+  // Maximum load factor is MAX_LOAD_NUMERATOR / MAX_LOAD_DENOMINATOR (7/8)
+  constexpr static size_t MAX_LOAD_NUMERATOR = 7;
+  constexpr static size_t MAX_LOAD_DENOMINATOR = 8;
+
+ public:
+  inline FlatMap() {}
+
+  inline FlatMap(const A& allocator) : m_allocator(allocator) {}
+
+  inline FlatMap(const FlatMap& rhs) : m_allocator(rhs.m_allocator) {
+    operator=(rhs);
+  }
+
+  inline FlatMap(FlatMap&& rhs) noexcept : m_allocator(rhs.m_allocator) {
+    take(rhs);
+  }
+
+  inline FlatMap(std::initializer_list<Pair<K, V>> il, const A& allocator = A()) : m_allocator(allocator) {
+    reserve(il.size());
+    for (auto& [k, v] : il) {
+      set(k, v);
+    }
+  }
+
+  inline virtual ~FlatMap() {
+    clear();
+  }
+
+  template <Allocator KA, Allocator VA>
+  static FlatMap fromArrays(const Array<K, KA>& keys, const Array<V, VA>& values, const A& allocator = A()) {
+    if (keys.size() != values.size()) throw MismatchedSizesException();
+    FlatMap result(allocator);
+    result.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      result.set(keys[i], values[i]);
+    }
+    return result;
+  }
+
+  inline size_t size() const {
+    return m_size;
+  }
+
+  inline size_t capacity() const {
+    return m_capacity;
+  }
+
+  inline const A& allocator() const { return m_allocator; }
+
+  inline double loadFactor() const {
+    if (!m_capacity) return 0.0;
+    return (double) m_size / m_capacity;
+  }
+
+  // Slots and control bytes, one allocation
+  inline size_t memoryUsage() const {
+    return m_capacity ? m_capacity * sizeof(Pair<K, V>) + m_capacity + GROUP_SIZE : 0;
+  }
+
+  inline MemoryStats stats() const {
+    MemoryStats result;
+    result.allocated = memoryUsage();
+    result.live = m_size * sizeof(Pair<K, V>);
+    result.rehashes = m_rehashes;
+    return result;
+  }
+
+  inline void clear() {
+    if (!m_capacity) return;
+    destroySlots();
+    deallocate(m_slots, m_capacity);
+    m_ctrl = nullptr;
+    m_slots = nullptr;
+    m_capacity = 0;
+    m_size = 0;
+    m_growthLeft = 0;
+  }
+
+  // Makes room for size elements without rehashing
+  inline void reserve(size_t size) {
+    size_t capacity = m_capacity ? m_capacity : INITIAL_SIZE;
+    while (maxLoad(capacity) < size) capacity *= GROWTH_FACTOR;
+    if (capacity > m_capacity) rehash(capacity);
+  }
+
+  inline Iterator begin() { return Iterator(this, 0); }
+  inline Iterator end() { return Iterator(this, m_capacity); }
+
+  inline ConstIterator cbegin() const { return ConstIterator(this, 0); }
+  inline ConstIterator cend() const { return ConstIterator(this, m_capacity); }
+
+  inline void set(const K& key, const V& value) {
+    size_t hash = mixHash(getHash(key));
+    size_t index = findIndex(key, hash);
+    if (index != nidx) {
+      m_slots[index]._2 = value;
+      return;
+    }
+    index = prepareInsert(hash);
+    new (m_slots + index) Pair<K, V>(key, value);
+  }
+
+  inline V& get(const K& key) {
+    size_t hash = mixHash(getHash(key));
+    size_t index = findIndex(key, hash);
+    if (index != nidx) {
+      return m_slots[index]._2;
+    }
+    index = prepareInsert(hash);
+    new (m_slots + index) Pair<K, V>(key, V());
+    return m_slots[index]._2;
+  }
+
+  inline const V& get(const K& key) const {
+    size_t index = findIndex(key, mixHash(getHash(key)));
+    if (index == nidx) throw NoSuchElementException();
+    return m_slots[index]._2;
+  }
+
+  inline const V& get(const K& key, const V& defaultValue) const {
+    size_t index = findIndex(key, mixHash(getHash(key)));
+    return index != nidx ? m_slots[index]._2 : defaultValue;
+  }
+
+  inline void remove(const K& key) {
+    size_t index = findIndex(key, mixHash(getHash(key)));
+    if (index == nidx) throw NoSuchElementException();
+    eraseAt(index);
+  }
+
+  inline bool contains(const K& key) const {
+    return findIndex(key, mixHash(getHash(key))) != nidx;
+  }
+
+  inline Array<K, A> keys() const {
+    Array<K, A> result = Array<K, A>::empty(m_size + 1, m_allocator);
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      result.append(m_slots[i]._1);
+    }
+    return result;
+  }
+
+  inline Array<V, A> values() const {
+    Array<V, A> result = Array<V, A>::empty(m_size + 1, m_allocator);
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      result.append(m_slots[i]._2);
+    }
+    return result;
+  }
+
+  inline Array<Pair<K, V>, A> items() const {
+    Array<Pair<K, V>, A> result = Array<Pair<K, V>, A>::empty(m_size + 1, m_allocator);
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      result.append(m_slots[i]);
+    }
+    return result;
+  }
+
+  // Lazy single-pass pipeline over the items, see View
+  inline auto view() const {
+    return makeView<Pair<K, V>>([this](auto&& sink) {
+      for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+        if (!sink(m_slots[i])) return;
+      }
+    });
+  }
+
+  template <Consumer<const Pair<K, V>&> F>
+  inline void foreach(F f) const {
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      f(m_slots[i]);
+    }
+  }
+
+  template <Predicate<const Pair<K, V>&> F>
+  inline FlatMap filter(F pred) const {
+    FlatMap result(m_allocator);
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      if (pred(m_slots[i])) {
+        result.set(m_slots[i]._1, m_slots[i]._2);
+      }
+    }
+    return result;
+  }
+
+  template <typename R, Callable<R, R, const Pair<K, V>&> F>
+  inline R reduce(F reducer, R startValue = {}) const {
+    R result = startValue;
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      result = reducer(result, m_slots[i]);
+    }
+    return result;
+  }
+
+  template <typename NK = K, typename NV = V, Callable<Pair<NK, NV>, const Pair<K, V>&> F>
+  inline FlatMap<NK, NV, A> map(F mapper) const {
+    FlatMap<NK, NV, A> result(m_allocator);
+    result.reserve(m_size);
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      auto p = mapper(m_slots[i]);
+      result.set(p._1, p._2);
+    }
+    return result;
+  }
+
+  template <typename T, Callable<T, const Pair<K, V>&> F>
+  inline Array<T, A> flatMap(F mapper) const {
+    Array<T, A> result = Array<T, A>::empty(m_size + 1, m_allocator);
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      result.append(mapper(m_slots[i]));
+    }
+    return result;
+  }
+
+  inline V& operator[](const K& key) {
+    return get(key);
+  }
+
+  inline const V& operator[](const K& key) const {
+    return get(key);
+  }
+
+  inline FlatMap& operator=(const FlatMap& rhs) {
+    if (this == &rhs) return *this;
+    clear();
+    reserve(rhs.m_size);
+    for (size_t i = rhs.nextFull(0); i < rhs.m_capacity; i = rhs.nextFull(i + 1)) {
+      set(rhs.m_slots[i]._1, rhs.m_slots[i]._2);
+    }
+    return *this;
+  }
+
+  /*
+    Allocates, and so can throw, when allocators differ: the slots can't change hands, entries are
+    copied instead. rhs is left empty either way.
+  */
+  inline FlatMap& operator=(FlatMap&& rhs) {
+    if (this == &rhs) return *this;
+    clear();
+    if (m_allocator == rhs.m_allocator) {
+      take(rhs);
+    } else {
+      *this = rhs;
+      rhs.clear();
+    }
+    return *this;
+  }
+
+  inline bool operator==(const FlatMap& rhs) const {
+    if (m_size != rhs.m_size) return false;
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      size_t index = rhs.findIndex(m_slots[i]._1, mixHash(getHash(m_slots[i]._1)));
+      if (index == nidx || rhs.m_slots[index]._2 != m_slots[i]._2) return false;
+    }
+    return true;
+  }
+
+  inline bool operator!=(const FlatMap& rhs) const {
+    return !operator==(rhs);
+  }
+
+  inline FlatMap operator+(const FlatMap& rhs) const {
+    FlatMap result = *this;
+    result.reserve(m_size + rhs.m_size);
+    for (size_t i = rhs.nextFull(0); i < rhs.m_capacity; i = rhs.nextFull(i + 1)) {
+      result.set(rhs.m_slots[i]._1, rhs.m_slots[i]._2);
+    }
+    return result;
+  }
+
+ private:
+  // Control bytes, full slots hold 7 bits of the hash (0..127)
+  constexpr static int8_t EMPTY = -128;
+  constexpr static int8_t DELETED = -2;
+
+  // Bitmask over a group of 16 control bytes, bit i is set if slot i matches
+  class Group {
+   public:
+    inline Group(const int8_t* ctrl) {
+#if defined(__SSE2__)
+      m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+      std::memcpy(m_ctrl, ctrl, GROUP_SIZE);
+#endif
+    }
+
+    inline uint32_t match(int8_t h2) const {
+#if defined(__SSE2__)
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(h2)));
+#else
+      uint32_t mask = 0;
+      for (size_t i = 0; i < GROUP_SIZE; i++) {
+        mask |= (uint32_t) (m_ctrl[i] == h2) << i;
+      }
+      return mask;
+#endif
+    }
+
+    inline uint32_t matchEmpty() const {
+      return match(EMPTY);
+    }
+
+    // EMPTY and DELETED are the only negative control bytes
+    inline uint32_t matchEmptyOrDeleted() const {
+#if defined(__SSE2__)
+      return _mm_movemask_epi8(m_ctrl);
+#else
+      uint32_t mask = 0;
+      for (size_t i = 0; i < GROUP_SIZE; i++) {
+        mask |= (uint32_t) (m_ctrl[i] < 0) << i;
+      }
+      return mask;
+#endif
+    }
+
+   private:
+#if defined(__SSE2__)
+    __m128i m_ctrl;
+#else
+    int8_t m_ctrl[GROUP_SIZE];
+#endif
+  };
+
+  inline static size_t h1(size_t hash) { return hash >> 7; }
+  inline static int8_t h2(size_t hash) { return hash & 0x7F; }
+
+  inline static size_t maxLoad(size_t capacity) {
+    return capacity / MAX_LOAD_DENOMINATOR * MAX_LOAD_NUMERATOR;
+  }
+
+  // Visits every group exactly once when capacity is a power of two
+  inline size_t probeNext(size_t pos, size_t& step) const {
+    step += GROUP_SIZE;
+    return (pos + step) & (m_capacity - 1);
+  }
+
+  inline size_t findIndex(const K& key, size_t hash) const {
+    if (!m_capacity) return nidx;
+    size_t pos = h1(hash) & (m_capacity - 1), step = 0;
+    while (true) {
+      Group group(m_ctrl + pos);
+      for (uint32_t mask = group.match(h2(hash)); mask; mask &= mask - 1) {
+        size_t index = (pos + __builtin_ctz(mask)) & (m_capacity - 1);
+        if (m_slots[index]._1 == key) return index;
+      }
+      if (group.matchEmpty()) return nidx;
+      pos = probeNext(pos, step);
+    }
+  }
+
+  inline size_t findFirstNonFull(size_t hash) const {
+    size_t pos = h1(hash) & (m_capacity - 1), step = 0;
+    while (true) {
+      uint32_t mask = Group(m_ctrl + pos).matchEmptyOrDeleted();
+      if (mask) return (pos + __builtin_ctz(mask)) & (m_capacity - 1);
+      pos = probeNext(pos, step);
+    }
+  }
+
+  // Returns index of an uninitialized slot for a key that isn't in the map yet
+  inline size_t prepareInsert(size_t hash) {
+    if (!m_capacity) rehash(INITIAL_SIZE);
+    size_t index = findFirstNonFull(hash);
+    if (!m_growthLeft && m_ctrl[index] == EMPTY) {
+      // Tombstones are dropped if they take up enough room, otherwise the table grows
+      rehash(m_size + 1 <= maxLoad(m_capacity) / 2 ? m_capacity : m_capacity * GROWTH_FACTOR);
+      index = findFirstNonFull(hash);
+    }
+    if (m_ctrl[index] == EMPTY) m_growthLeft--;
+    setCtrl(index, h2(hash));
+    m_size++;
+    return index;
+  }
+
+  inline void eraseAt(size_t index) {
+    m_slots[index].~Pair<K, V>();
+    m_size--;
+    // Slot can become EMPTY only if no probe sequence could have passed over it as part of a full group
+    size_t before = (index - GROUP_SIZE) & (m_capacity - 1);
+    uint32_t emptyAfter = Group(m_ctrl + index).matchEmpty();
+    uint32_t emptyBefore = Group(m_ctrl + before).matchEmpty();
+    bool wasNeverFull = emptyBefore && emptyAfter
+      && (size_t) (__builtin_ctz(emptyAfter) + __builtin_clz(emptyBefore << 16)) < GROUP_SIZE;
+    setCtrl(index, wasNeverFull ? EMPTY : DELETED);
+    if (wasNeverFull) m_growthLeft++;
+  }
+
+  // First GROUP_SIZE control bytes are mirrored past the end, so groups can be loaded without wrapping
+  inline void setCtrl(size_t index, int8_t value) {
+    m_ctrl[index] = value;
+    if (index < GROUP_SIZE) m_ctrl[m_capacity + index] = value;
+  }
+
+  inline size_t nextFull(size_t index) const {
+    while (index < m_capacity && m_ctrl[index] < 0) index++;
+    return index < m_capacity ? index : m_capacity;
+  }
+
+  inline void rehash(size_t capacity) {
+    int8_t* oldCtrl = m_ctrl;
+    Pair<K, V>* oldSlots = m_slots;
+    size_t oldCapacity = m_capacity;
+
+    allocate(capacity);
+    if (oldCapacity) m_rehashes++;
+    for (size_t i = 0; i < oldCapacity; i++) {
+      if (oldCtrl[i] >= 0) {
+        size_t hash = mixHash(getHash(oldSlots[i]._1));
+        size_t index = findFirstNonFull(hash);
+        setCtrl(index, h2(hash));
+        new (m_slots + index) Pair<K, V>(std::move(oldSlots[i]));
+        oldSlots[i].~Pair<K, V>();
+      }
+    }
+    m_growthLeft = maxLoad(m_capacity) - m_size;
+
+    if (oldCapacity) deallocate(oldSlots, oldCapacity);
+  }
+
+  // Slots and control bytes share one allocation, slots first to keep them aligned
+  inline void allocate(size_t capacity) {
+    void* memory = m_allocator.allocate(capacity * sizeof(Pair<K, V>) + capacity + GROUP_SIZE, alignof(Pair<K, V>));
+    m_slots = static_cast<Pair<K, V>*>(memory);
+    m_ctrl = reinterpret_cast<int8_t*>(m_slots + capacity);
+    std::memset(m_ctrl, EMPTY, capacity + GROUP_SIZE);
+    m_capacity = capacity;
+  }
+
+  inline void deallocate(Pair<K, V>* slots, size_t capacity) {
+    m_allocator.deallocate(slots, capacity * sizeof(Pair<K, V>) + capacity + GROUP_SIZE, alignof(Pair<K, V>));
+  }
+
+  inline void destroySlots() {
+    for (size_t i = nextFull(0); i < m_capacity; i = nextFull(i + 1)) {
+      m_slots[i].~Pair<K, V>();
+    }
+  }
+
+  inline void take(FlatMap& rhs) {
+    m_ctrl = rhs.m_ctrl;
+    m_slots = rhs.m_slots;
+    m_size = rhs.m_size;
+    m_capacity = rhs.m_capacity;
+    m_growthLeft = rhs.m_growthLeft;
+    m_rehashes = rhs.m_rehashes;
+    rhs.m_ctrl = nullptr;
+    rhs.m_slots = nullptr;
+    rhs.m_size = 0;
+    rhs.m_capacity = 0;
+    rhs.m_growthLeft = 0;
+    rhs.m_rehashes = 0;
+  }
+
+ private:
+  int8_t* m_ctrl = nullptr;
+  Pair<K, V>* m_slots = nullptr;
+  size_t m_size = 0;
+  size_t m_capacity = 0;
+  size_t m_growthLeft = 0;
+  size_t m_rehashes = 0;
+  [[no_unique_address]] A m_allocator;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_FLAT_MAP_H_ */
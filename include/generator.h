@@ -7,6 +7,7 @@
 #include <mrt/utils/concepts.h>
 #include <mrt/iterator.h>
 #include <mrt/iterable.h>
+#include <mrt/view.h>
 #include <mrt/pair.h>
 
 namespace mrt {
@@ -89,7 +90,17 @@ class Generator {
     return Iterator();
   }
 
-  void foreach(std::function<void(const T&)> f) {
+  // Lazy pipeline over generated values, the view keeps its own copy of the generator function
+  inline auto view() const {
+    return makeView<T>([function = m_function](auto&& sink) {
+      for (Iterator it(function); it != Iterator(); ++it) {
+        if (!sink(*it)) return;
+      }
+    });
+  }
+
+  template <Consumer<const T&> F>
+  void foreach(F f) {
     for (auto iter : *this) {
       f(iter);
     }
@@ -4,13 +4,19 @@
 #include <initializer_list>
 #include <functional>
 #include <concepts>
+#include <utility>
 #include <cstdlib>
 #include <mrt/utils/constants.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/hash_set.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
 #include <mrt/array.h>
+#include <mrt/view.h>
 
 namespace mrt {
 
-template <typename T>
+template <typename T, Allocator A = DefaultAllocator>
 class List {
  public:
   struct Node {
@@ -131,13 +137,15 @@ class List {
  public:
   inline List() {}
 
-  inline List(const List& rhs) {
+  inline List(const A& allocator) : m_allocator(allocator) {}
+
+  inline List(const List& rhs) : m_allocator(rhs.m_allocator) {
     for (Node* node = rhs.m_head; node; node = node->next) {
       append(node->value);
     }
   }
 
-  inline List(std::initializer_list<T> il) {
+  inline List(std::initializer_list<T> il, const A& allocator = A()) : m_allocator(allocator) {
     for (auto x : il) {
       append(x);
     }
@@ -148,6 +156,20 @@ class List {
   }
 
   inline size_t size() const { return m_size; }
+  inline const A& allocator() const { return m_allocator; }
+
+  // One node per element, links are the slack
+  inline size_t memoryUsage() const {
+    return m_size * sizeof(Node);
+  }
+
+  inline MemoryStats stats() const {
+    MemoryStats result;
+    result.allocated = memoryUsage();
+    result.live = m_size * sizeof(T);
+    result.nodes = m_size;
+    return result;
+  }
   inline Iterator head() const { return Iterator(this, m_head); }
   inline Iterator tail() const { return Iterator(this, m_tail); }
 
@@ -159,7 +181,7 @@ class List {
 
   inline void append(const T& element) {
     if (!m_tail) {
-      m_tail = new Node(element);
+      m_tail = createNode(element);
       m_head = m_tail;
       m_size++;
     } else {
@@ -169,7 +191,7 @@ class List {
 
   inline void prepend(const T& element) {
     if (!m_head) {
-      m_head = new Node(element);
+      m_head = createNode(element);
       m_tail = m_head;
       m_size++;
     } else {
@@ -203,8 +225,11 @@ class List {
   }  
 
   inline void clear() {
-    for (Node* node = m_head; node; node = node->next) {
-      delete node;
+    Node* node = m_head;
+    while (node) {
+      Node* next = node->next;
+      destroyNode(node);
+      node = next;
     }
     m_head = nullptr;
     m_tail = nullptr;
@@ -221,8 +246,17 @@ class List {
     return false;
   }
 
+  // Lazy single-pass pipeline over the elements, see View
+  inline auto view() const {
+    return makeView<T>([this](auto&& sink) {
+      for (Node* node = m_head; node; node = node->next) {
+        if (!sink(node->value)) return;
+      }
+    });
+  }
+
   inline List slice(size_t start, size_t end = 0) const {
-    List result;
+    List result(m_allocator);
 
     if (end == 0) {
       size_t index = 0;
@@ -247,8 +281,8 @@ class List {
     return result;
   }
 
-  inline Array<size_t> find(const T& value, size_t startIdx = 0) const {
-    Array<size_t> indexes;
+  inline Array<size_t, A> find(const T& value, size_t startIdx = 0) const {
+    Array<size_t, A> indexes(m_allocator);
 
     size_t index = 0;
     for (Node* node = m_head; node; node = node->next) {
@@ -291,26 +325,60 @@ class List {
     return nidx;
   }
 
-  inline List unique() {
-    List result;
+  // Keeps first occurrence of every value, in order
+  inline List unique() const {
+    List result(m_allocator);
 
-    for (auto& value : *this) {
-      if (!result.contains(value)) {
-        result.append(value);
+    if constexpr (Ordered<T>) {
+      if (isSorted()) {
+        // Duplicates of a sorted list are adjacent
+        for (Node* node = m_head; node; node = node->next) {
+          if (node == m_head || !(node->value == node->prev->value)) {
+            result.append(node->value);
+          }
+        }
+        return result;
+      }
+    }
+
+    if constexpr (HashKey<T>) {
+      HashSet<T, A> seen(size(), m_allocator);
+      for (Node* node = m_head; node; node = node->next) {
+        if (seen.insert(node->value)) {
+          result.append(node->value);
+        }
+      }
+    } else {
+      for (Node* node = m_head; node; node = node->next) {
+        if (!result.contains(node->value)) {
+          result.append(node->value);
+        }
       }
     }
 
     return result;
   }
 
-  inline void foreach(std::function<void(const T&)> f) {
+  // Ascending by operator<, checked in one pass that stops at the first inversion
+  inline bool isSorted() const requires Ordered<T> {
+    for (Node* node = m_head; node && node->next; node = node->next) {
+      if (node->next->value < node->value) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <Consumer<const T&> F>
+  inline void foreach(F f) {
     for (Node* node = m_head; node; node = node->next) {
       f(node->value);
     }
   }
 
-  inline List filter(std::function<bool(const T&)> pred) {
-    List result;
+  template <Predicate<const T&> F>
+  inline List filter(F pred) {
+    List result(m_allocator);
     for (Node* node = m_head; node; node = node->next) {
       if (pred(node->value)) {
         result.append(node->value);
@@ -320,8 +388,8 @@ class List {
     return result;
   }
 
-  template <typename R>
-  inline R reduce(std::function<R(R, const T&)> reducer, R startValue = {}) {
+  template <typename R, Callable<R, R, const T&> F>
+  inline R reduce(F reducer, R startValue = {}) {
     R result = startValue;
     for (Node* node = m_head; node; node = node->next) {
       result = reducer(result, node->value);
@@ -329,8 +397,8 @@ class List {
     return result;
   }
 
-  template <typename R>
-  inline R reduceRight(std::function<R(R, const T&)> reducer, R startValue = {}) {
+  template <typename R, Callable<R, R, const T&> F>
+  inline R reduceRight(F reducer, R startValue = {}) {
     R result = startValue;
     for (Node* node = m_tail; node; node = node->prev) {
       result = reducer(result, node->value);
@@ -338,9 +406,9 @@ class List {
     return result;
   }
 
-  template <typename R = T>
-  inline List<R> map(std::function<R(const T&)> mapper) const {
-    List<R> result;
+  template <typename R = T, Callable<R, const T&> F>
+  inline List<R, A> map(F mapper) const {
+    List<R, A> result(m_allocator);
     for (Node* node = m_head; node; node = node->next) {
       result.append(mapper(node->value));
     }
@@ -408,7 +476,7 @@ class List {
   }
 
   inline List operator+(const List& rhs) const {
-    List result;
+    List result(m_allocator);
 
     for (Node* node = m_head; node; node = node->next) {
       result.append(node->value);
@@ -421,31 +489,56 @@ class List {
     return result;
   }
 
+  // Elements that are also in rhs
   inline List operator&(const List& rhs) const {
-    List result;
-
-    for (Node* node = m_head; node; node = node->next) {
-      if (rhs.contains(node->value)) {
-        result.append(node->value);
-      }
-    }
-
-    return result;
+    return select(rhs, true);
   }
 
+  // Elements that are not in rhs
   inline List operator|(const List& rhs) const {
-    List result;
+    return select(rhs, false);
+  }
 
-    for (Node* node = m_head; node; node = node->next) {
-      if (!rhs.contains(node->value)) {
-        result.append(node->value);
+ private:
+  // Keeps elements whose presence in rhs equals present, in order
+  inline List select(const List& rhs, bool present) const {
+    List result(m_allocator);
+
+    if constexpr (Ordered<T>) {
+      if (isSorted() && rhs.isSorted()) {
+        // Both sorted: single merge-like pass, other is the first node of rhs not less than node
+        Node* other = rhs.m_head;
+        for (Node* node = m_head; node; node = node->next) {
+          while (other && other->value < node->value) other = other->next;
+          if ((other && other->value == node->value) == present) {
+            result.append(node->value);
+          }
+        }
+        return result;
+      }
+    }
+
+    if constexpr (HashKey<T>) {
+      HashSet<T, A> set(rhs.size(), m_allocator);
+      for (Node* node = rhs.m_head; node; node = node->next) {
+        set.insert(node->value);
+      }
+      for (Node* node = m_head; node; node = node->next) {
+        if (set.contains(node->value) == present) {
+          result.append(node->value);
+        }
+      }
+    } else {
+      for (Node* node = m_head; node; node = node->next) {
+        if (rhs.contains(node->value) == present) {
+          result.append(node->value);
+        }
       }
     }
 
     return result;
   }
 
- private:
   inline Node* getNode(size_t index) {
     Node* node = nullptr;
     if (node >= 0) {
@@ -470,7 +563,7 @@ class List {
 
   inline Node* insertAfter(Node* node, const T& value) {
     if (!node) return nullptr;
-    Node* newNode = new Node(value, node, node->next);
+    Node* newNode = createNode(value, node, node->next);
     if (node->next)
       node->next->prev = newNode;
     node->next = newNode;
@@ -480,7 +573,7 @@ class List {
 
   inline Node* insertBefore(Node* node, const T& value) {
     if (!node) return nullptr;
-    Node* newNode = new Node(value, node->prev, node);
+    Node* newNode = createNode(value, node->prev, node);
     if (node->prev)
       node->prev->next = newNode;
     node->prev = newNode;
@@ -506,7 +599,17 @@ class List {
 
     m_size--;
 
-    delete node;
+    destroyNode(node);
+  }
+
+  template <typename... Args>
+  inline Node* createNode(Args&&... args) {
+    return new (m_allocator.allocate(sizeof(Node), alignof(Node))) Node(std::forward<Args>(args)...);
+  }
+
+  inline void destroyNode(Node* node) {
+    node->~Node();
+    m_allocator.deallocate(node, sizeof(Node), alignof(Node));
   }
 
   inline void repairHeadTail(Node* node) {
@@ -518,6 +621,7 @@ class List {
   Node* m_head = nullptr;
   Node* m_tail = nullptr;
   size_t m_size = 0;
+  [[no_unique_address]] A m_allocator;
 };
 
 } /* namespace mrt */
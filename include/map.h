@@ -4,73 +4,19 @@
 #include <initializer_list>
 #include <functional>
 #include <exception>
+#include <utility>
 #include <cstdlib>
 #include <mrt/utils/concepts.h>
+#include <mrt/utils/hash.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
 #include <mrt/array.h>
+#include <mrt/view.h>
 #include <mrt/pair.h>
 
 namespace mrt {
 
-template <typename T>
-inline size_t getHash(const T& value) {
-  return std::hash(value);
-}
-
-template <Hashable T>
-inline size_t getHash(const T& value) {
-  return value.hash();
-}
-
-template <IsEnum T>
-inline size_t getHash(const T& value) {
-  return (size_t) value;
-}
-
-template <>
-inline size_t getHash(const int& value) {
-  return value;
-}
-
-template <>
-inline size_t getHash(const long& value) {
-  return value;
-}
-
-template <>
-inline size_t getHash(const long long& value) {
-  return value;
-}
-
-template <>
-inline size_t getHash(const unsigned& value) {
-  return value;
-}
-
-template <>
-inline size_t getHash(const unsigned long& value) {
-  return value;
-}
-
-template <>
-inline size_t getHash(const unsigned long long& value) {
-  return value;
-}
-
-template <>
-inline size_t getHash(const float& value) {
-  return *(size_t*)((void*)&value);
-}
-
-template <>
-inline size_t getHash(const double& value) {
-  return *(size_t*)((void*)&value);
-}
-
-inline size_t getHash(const void* value) {
-  return (size_t) value;
-}
-
-template <typename K, typename V>
+template <typename K, typename V, Allocator A = DefaultAllocator>
 class Map {
  public:
   struct NoSuchElementException : public std::exception {
@@ -81,6 +27,12 @@ class Map {
     inline MismatchedSizesException() {}
   };
 
+  // chainLengths[n] is the number of buckets holding n nodes
+  struct Stats : public MemoryStats {
+    size_t longestChain = 0;
+    Array<size_t> chainLengths;
+  };
+
   struct Node {
     Pair<K, V> data;
     Node* next = nullptr;
@@ -300,17 +252,23 @@ class Map {
   constexpr static size_t INITIAL_SIZE = 32;
   constexpr static double GROWTH_FACTOR = 2;
   constexpr static double MAX_LOAD_FACTOR = 0.75;
+  // Old buckets migrated per operation while resizing incrementally
+  constexpr static size_t MIGRATION_STEP = 4;
 
  public:
   inline Map() {
     recreateBuckets();
   }
 
-  inline Map(const Map& rhs) {
+  inline Map(const A& allocator) : m_allocator(allocator) {
+    recreateBuckets();
+  }
+
+  inline Map(const Map& rhs) : m_allocator(rhs.m_allocator) {
     operator=(rhs);
   }
 
-  inline Map(std::initializer_list<Pair<K, V>> il) {
+  inline Map(std::initializer_list<Pair<K, V>> il, const A& allocator = A()) : m_allocator(allocator) {
     for (auto& [k, v] : il) {
       set(k, v);
     }
@@ -320,9 +278,10 @@ class Map {
     clear();
   }
 
-  static Map fromArrays(const Array<K>& keys, const Array<V>& values) {
+  template <Allocator KA, Allocator VA>
+  static Map fromArrays(const Array<K, KA>& keys, const Array<V, VA>& values, const A& allocator = A()) {
     if (keys.size() != values.size()) throw MismatchedSizesException();
-    Map result;
+    Map result(allocator);
     for (size_t i = 0; i < keys.size(); i++) {
       result[keys[i]] = values[i];
     }
@@ -337,214 +296,182 @@ class Map {
     return m_capacity;
   }
 
+  inline const A& allocator() const { return m_allocator; }
+
   inline double loadFactor() const {
     if (!m_capacity) return 0.0;
-    return m_size / m_capacity;
+    return (double) m_size / m_capacity;
+  }
+
+  // Bytes held from the allocator: bucket arrays (both of them while resizing) and nodes
+  inline size_t memoryUsage() const {
+    size_t buckets = (m_buckets ? m_capacity : 0) + m_oldCapacity;
+    return buckets * sizeof(Node*) + m_size * sizeof(Node);
+  }
+
+  // Walks every chain, O(capacity + size)
+  inline Stats stats() const {
+    Stats result;
+    result.allocated = memoryUsage();
+    result.live = m_size * sizeof(Pair<K, V>);
+    result.nodes = m_size;
+    result.rehashes = m_rehashes;
+    forEachBucket([&result](Node* node) {
+      size_t length = 0;
+      for (; node; node = node->next) length++;
+      while (result.chainLengths.size() <= length) result.chainLengths.append(0);
+      result.chainLengths[length]++;
+      if (length > result.longestChain) result.longestChain = length;
+    });
+    return result;
   }
 
   inline void clear() {
-    for (auto node : m_buckets) {
-      if (node) delete node;
-    }
-    m_buckets.clear();
+    forEachNode([this](Node* node) { destroyNode(node); });
+    deallocateBuckets(m_buckets, m_capacity);
+    deallocateBuckets(m_oldBuckets, m_oldCapacity);
+    m_buckets = nullptr;
+    m_oldBuckets = nullptr;
     m_capacity = 0;
+    m_oldCapacity = 0;
+    m_migrated = 0;
     m_size = 0;
   }
 
-  inline Iterator begin() { return Iterator(this, 0); }
-  inline Iterator end() { return Iterator(this, m_capacity); }
+  /*
+    In incremental resize mode growing doesn't relink the whole map at once. Old and new
+    bucket arrays coexist and every set/get/remove migrates up to MIGRATION_STEP old buckets.
+  */
+  inline void setIncrementalResize(bool incremental) {
+    if (!incremental) finishMigration();
+    m_incremental = incremental;
+  }
+
+  inline bool isIncrementalResize() const {
+    return m_incremental;
+  }
+
+  inline bool isResizing() const {
+    return m_oldCapacity != 0;
+  }
+
+  inline Iterator begin() { finishMigration(); return Iterator(this, 0); }
+  inline Iterator end() { finishMigration(); return Iterator(this, m_capacity); }
 
   inline ConstIterator cbegin() const { return ConstIterator(this, 0); }
   inline ConstIterator cend() const { return ConstIterator(this, m_capacity); }
 
   inline void set(const K& key, const V& value) {
+    migrateStep();
+    Node* node = findNode(key);
+    if (node) {
+      node->value() = value;
+      return;
+    }
     addNewNode(key, value);
   }
 
   inline V& get(const K& key) {
-    if (!m_capacity) recreateBuckets();
-    size_t index = getHash(key) % m_capacity;
-
-    if (!m_buckets[index]) {
-      m_buckets[index] = new Node(key);
-      return m_buckets[index]->value();
-    }
-
-    Node* node = m_buckets[index];
-    while (node->key() != key && node->next) {
-      node = node->next;
-    }
-
-    return node->value();
+    migrateStep();
+    Node* node = findNode(key);
+    if (node) return node->value();
+    return addNewNode(key, V())->value();
   }
 
   inline const V& get(const K& key) const {
-    if (!m_capacity) throw NoSuchElementException();
-    size_t index = getHash(key) % m_capacity;
-
-    if (!m_buckets[index]) {
-      return m_buckets[index]->value();
-    }
-
-    Node* node = m_buckets[index];
-    while (node->key() != key && node->next) {
-      node = node->next;
-    }
-
+    Node* node = findNode(key);
+    if (!node) throw NoSuchElementException();
     return node->value();
   }
 
   inline const V& get(const K& key, const V& defaultValue) const {
-    return contains(key) ? get(key) : defaultValue;
+    Node* node = findNode(key);
+    return node ? node->value() : defaultValue;
   }
 
   inline void remove(const K& key) {
     if (!m_capacity) return;
-    size_t index = getHash(key) % m_capacity;
+    migrateStep();
 
-    if (m_buckets[index]) {
-      if (m_buckets[index]->key() == key) {
-        Node* node = m_buckets[index];
-        m_buckets[index] = m_buckets[index]->next;
+    for (Node** link = findBucket(key); *link; link = &(*link)->next) {
+      if ((*link)->key() == key) {
+        Node* node = *link;
+        *link = node->next;
         m_size -= 1;
-        delete node;
+        destroyNode(node);
         return;
-      } else {
-        Node* node = m_buckets[index];
-        while (node->next) {
-          if (node->next->key() == key) {
-            node->next = node->next->next;
-            m_size -= 1;
-            delete node;
-            return;
-          }
-          node = node->next;
-        }
       }
     }
 
     throw NoSuchElementException();
   }
 
-  inline Array<K> keys() const {
-    Array<K> result;
-    for (size_t i = 0; i < m_capacity; i++) {
-      if (m_buckets[i]) {
-        Node* node = m_buckets[i];
-        while (node) {
-          result.append(node->key());
-          node = node->next;
-        }
-      }
-    }
+  inline Array<K, A> keys() const {
+    Array<K, A> result(m_allocator);
+    forEachNode([&result](Node* node) { result.append(node->key()); });
     return result;
   }
 
-  inline Array<V> values() const {
-    Array<V> result;
-    for (size_t i = 0; i < m_capacity; i++) {
-      if (m_buckets[i]) {
-        Node* node = m_buckets[i];
-        while (node) {
-          result.append(node->value());
-          node = node->next;
-        }
-      }
-    }
+  inline Array<V, A> values() const {
+    Array<V, A> result(m_allocator);
+    forEachNode([&result](Node* node) { result.append(node->value()); });
     return result;
   }
 
-  inline Array<Pair<K, V>> items() const {
-    Array<Pair<K, V>> result;
-    for (size_t i = 0; i < m_capacity; i++) {
-      if (m_buckets[i]) {
-        Node* node = m_buckets[i];
-        while (node) {
-          result.append(node->pair());
-          node = node->next;
-        }
-      }
-    }
+  inline Array<Pair<K, V>, A> items() const {
+    Array<Pair<K, V>, A> result(m_allocator);
+    forEachNode([&result](Node* node) { result.append(node->pair()); });
     return result;
   }
 
-  inline bool contains(const K& key) const {
-    size_t index = getHash(key) % m_capacity;
+  // Lazy single-pass pipeline over the items, see View
+  inline auto view() const {
+    return makeView<Pair<K, V>>([this](auto&& sink) {
+      forEachNodeWhile([&sink](Node* node) { return sink(node->pair()); });
+    });
+  }
 
-    return m_buckets[index] != nullptr;
+  inline bool contains(const K& key) const {
+    return findNode(key) != nullptr;
   }
 
-  inline void foreach(std::function<void(const Pair<K, V>&)> f) {
-    for (size_t i = 0; i < m_capacity; i++) {
-      if (m_buckets[i]) {
-        Node* node = m_buckets[i];
-        while (node) {
-          f(node->pair());
-          node = node->next;
-        }
-      }
-    }
+  template <Consumer<const Pair<K, V>&> F>
+  inline void foreach(F f) {
+    forEachNode([&f](Node* node) { f(node->pair()); });
   }
 
-  inline Map filter(std::function<bool(const Pair<K, V>&)> pred) {
-    Map result;
-    for (size_t i = 0; i < m_capacity; i++) {
-      if (m_buckets[i]) {
-        Node* node = m_buckets[i];
-        while (node) {
-          if (pred(node->pair())) {
-            result.set(node->key(), node->value());
-          }
-          node = node->next;
-        }
+  template <Predicate<const Pair<K, V>&> F>
+  inline Map filter(F pred) {
+    Map result(m_allocator);
+    forEachNode([&](Node* node) {
+      if (pred(node->pair())) {
+        result.set(node->key(), node->value());
       }
-    }
+    });
     return result;
   }
 
-  template <typename R>
-  inline R reduce(std::function<R(R, const Pair<K, V>&)> reducer, R startValue = {}) {
+  template <typename R, Callable<R, R, const Pair<K, V>&> F>
+  inline R reduce(F reducer, R startValue = {}) {
     R result = startValue;
-    for (size_t i = 0; i < m_capacity; i++) {
-      if (m_buckets[i]) {
-        Node* node = m_buckets[i];
-        while (node) {
-          result = reducer(result, node->pair());
-          node = node->next;
-        }
-      }
-    }
+    forEachNode([&](Node* node) { result = reducer(result, node->pair()); });
     return result;
   }
 
-  template <typename NK = K, typename NV = V>
-  inline Map<NK, NV> map(std::function<Pair<NK, NV>(const Pair<K, V>&)> mapper) const {
-    Map<NK, NV> result;
-    for (size_t i = 0; i < m_capacity; i++) {
-      if (m_buckets[i]) {
-        Node* node = m_buckets[i];
-        while (node) {
-          auto p = mapper(node->pair());
-          result.set(p._1, p._2);
-          node = node->next;
-        }
-      }
-    }
+  template <typename NK = K, typename NV = V, Callable<Pair<NK, NV>, const Pair<K, V>&> F>
+  inline Map<NK, NV, A> map(F mapper) const {
+    Map<NK, NV, A> result(m_allocator);
+    forEachNode([&](Node* node) {
+      auto p = mapper(node->pair());
+      result.set(p._1, p._2);
+    });
     return result;
   }
 
-  template <typename T>
-  inline Array<T> flatMap(std::function<T(const Pair<K, V>&)> mapper) const {
-    Array<T> result;
-    for (size_t i = 0; i < m_capacity; i++) {
-      if (m_buckets[i]) {
-        Node* node = m_buckets[i];
-        while (node) {
-          result.append(mapper(node->pair()));
-          node = node->next;
-        }
-      }
-    }
+  template <typename T, Callable<T, const Pair<K, V>&> F>
+  inline Array<T, A> flatMap(F mapper) const {
+    Array<T, A> result(m_allocator);
+    forEachNode([&](Node* node) { result.append(mapper(node->pair())); });
     return result;
   }
 
@@ -557,18 +484,12 @@ class Map {
   }
 
   inline Map& operator=(const Map& rhs) {
+    if (this == &rhs) return *this;
     clear();
     m_capacity = rhs.m_capacity;
+    m_incremental = rhs.m_incremental;
     recreateBuckets();
-    for (size_t i = 0; i < rhs.m_capacity; i++) {
-      if (rhs.m_buckets[i]) {
-        Node* node = rhs.m_buckets[i];
-        while (node) {
-          set(node->key(), node->value());
-          node = node->next;
-        }
-      }
-    }
+    rhs.forEachNode([this](Node* node) { set(node->key(), node->value()); });
     return *this;
   }
 
@@ -598,57 +519,176 @@ class Map {
 
  private:
   void recreateBuckets() {
-    if (m_buckets.size()) {
-      auto buckets = m_buckets;
-      m_buckets = Array<Node*>::filled(m_capacity, nullptr);
-      for (auto& node : buckets) {
-        if (node) {
-          addNewNode(new Node(node->key(), node->value()), false);
-          Node* tmp = node->next;
-          while (tmp) {
-            addNewNode(tmp, false);
-            Node* toDelete = tmp;
-            tmp = tmp->next;
-            delete toDelete;
-          }
-        }
-      }
-      buckets.clear();
-    } else {
-      if (!m_capacity) m_capacity = INITIAL_SIZE;
-      m_buckets = Array<Node*>::filled(m_capacity, nullptr);
+    if (!m_capacity) m_capacity = INITIAL_SIZE;
+    m_buckets = allocateBuckets(m_capacity);
+  }
+
+  // Relinks every node into a new bucket array at once, nodes themselves aren't reallocated
+  void rehash(size_t capacity) {
+    m_rehashes++;
+    Node** buckets = m_buckets;
+    size_t oldCapacity = m_capacity;
+    m_capacity = capacity;
+    m_buckets = allocateBuckets(m_capacity);
+    for (size_t i = 0; i < oldCapacity; i++) {
+      relinkChain(buckets[i]);
+    }
+    deallocateBuckets(buckets, oldCapacity);
+  }
+
+  inline void relinkChain(Node* node) {
+    while (node) {
+      Node* next = node->next;
+      size_t index = getHash(node->key()) % m_capacity;
+      node->next = m_buckets[index];
+      m_buckets[index] = node;
+      node = next;
     }
   }
 
-  void addNewNode(Node* node, bool check = true) {
-    if (check) {
-      if (!m_buckets.size()) recreateBuckets();
-      if (loadFactor() >= MAX_LOAD_FACTOR) {
+  inline void grow() {
+    if (!m_buckets) recreateBuckets();
+    if (loadFactor() >= MAX_LOAD_FACTOR) {
+      if (m_incremental) {
+        // Previous migration is normally done long before the next growth, this only bounds the worst case
+        finishMigration();
+        m_rehashes++;
+        m_oldBuckets = m_buckets;
+        m_oldCapacity = m_capacity;
+        m_migrated = 0;
         m_capacity *= GROWTH_FACTOR;
-        recreateBuckets();
+        // Left uninitialized, new buckets are cleared as their old bucket is migrated
+        m_buckets = allocateBuckets(m_capacity, false);
+      } else {
+        rehash(m_capacity * GROWTH_FACTOR);
       }
     }
+  }
+
+  // Capacity doubles, so old bucket i only splits into new buckets i and i + m_oldCapacity
+  inline void migrateStep() {
+    if (!m_oldCapacity) return;
+    for (size_t i = 0; i < MIGRATION_STEP && m_migrated < m_oldCapacity; i++) {
+      m_buckets[m_migrated] = nullptr;
+      m_buckets[m_migrated + m_oldCapacity] = nullptr;
+      relinkChain(m_oldBuckets[m_migrated++]);
+    }
+    if (m_migrated == m_oldCapacity) {
+      deallocateBuckets(m_oldBuckets, m_oldCapacity);
+      m_oldBuckets = nullptr;
+      m_oldCapacity = 0;
+      m_migrated = 0;
+    }
+  }
 
-    if (!node) return;
+  inline void finishMigration() {
+    while (m_oldCapacity) {
+      migrateStep();
+    }
+  }
 
-    size_t index = getHash(node->key()) % m_capacity;
+  // Head of the chain key belongs to, buckets that weren't migrated yet are still looked up in the old array
+  inline Node** findBucket(const K& key) const {
+    size_t hash = getHash(key);
+    if (m_oldCapacity) {
+      size_t index = hash % m_oldCapacity;
+      if (index >= m_migrated) return m_oldBuckets + index;
+    }
+    return m_buckets + hash % m_capacity;
+  }
 
-    if (m_buckets[index]) {
-      if (m_buckets[index]->key() == node->key()) {
-        m_buckets[index]->value() = node->value();
-        delete node;
-      } else {
-        m_buckets[index]->addToChain(node);
+  inline Node* findNode(const K& key) const {
+    if (!m_capacity) return nullptr;
+    Node* node = *findBucket(key);
+    while (node && node->key() != key) {
+      node = node->next;
+    }
+    return node;
+  }
+
+  // Calls f(head) for every bucket that is in use, including empty ones
+  template <typename F>
+  inline void forEachBucket(F f) const {
+    if (m_oldCapacity) {
+      for (size_t i = 0; i < m_oldCapacity; i++) {
+        if (i < m_migrated) {
+          f(m_buckets[i]);
+          f(m_buckets[i + m_oldCapacity]);
+        } else {
+          f(m_oldBuckets[i]);
+        }
+      }
+    } else if (m_buckets) {
+      for (size_t i = 0; i < m_capacity; i++) {
+        f(m_buckets[i]);
+      }
+    }
+  }
+
+  template <typename F>
+  inline void forEachNode(F f) const {
+    forEachNodeWhile([&f](Node* node) { f(node); return true; });
+  }
+
+  // Stops as soon as f returns false
+  template <typename F>
+  inline void forEachNodeWhile(F f) const {
+    if (m_oldCapacity) {
+      // Only new buckets of already migrated old buckets are initialized
+      for (size_t i = 0; i < m_oldCapacity; i++) {
+        if (i < m_migrated) {
+          if (!forEachInChain(m_buckets[i], f) || !forEachInChain(m_buckets[i + m_oldCapacity], f)) return;
+        } else {
+          if (!forEachInChain(m_oldBuckets[i], f)) return;
+        }
       }
     } else {
-      m_buckets[index] = node;
+      for (size_t i = 0; i < m_capacity; i++) {
+        if (!forEachInChain(m_buckets[i], f)) return;
+      }
     }
+  }
 
+  template <typename F>
+  inline static bool forEachInChain(Node* node, F& f) {
+    while (node) {
+      Node* next = node->next;
+      if (!f(node)) return false;
+      node = next;
+    }
+    return true;
+  }
+
+  Node* addNewNode(const K& key, const V& value) {
+    grow();
+    Node** bucket = findBucket(key);
+    *bucket = createNode(key, value, *bucket);
     m_size += 1;
+    return *bucket;
+  }
+
+  template <typename... Args>
+  inline Node* createNode(Args&&... args) {
+    return new (m_allocator.allocate(sizeof(Node), alignof(Node))) Node(std::forward<Args>(args)...);
+  }
+
+  inline void destroyNode(Node* node) {
+    node->~Node();
+    m_allocator.deallocate(node, sizeof(Node), alignof(Node));
+  }
+
+  inline Node** allocateBuckets(size_t capacity, bool clear = true) {
+    Node** buckets = static_cast<Node**>(m_allocator.allocate(capacity * sizeof(Node*), alignof(Node*)));
+    if (clear) {
+      for (size_t i = 0; i < capacity; i++) {
+        buckets[i] = nullptr;
+      }
+    }
+    return buckets;
   }
 
-  void addNewNode(const K& key, const V& value) {
-    addNewNode(new Node(key, value));
+  inline void deallocateBuckets(Node** buckets, size_t capacity) {
+    if (buckets) m_allocator.deallocate(buckets, capacity * sizeof(Node*), alignof(Node*));
   }
 
   Node* getAtIndex(size_t index) {
@@ -662,7 +702,14 @@ class Map {
  private:
   size_t m_size = 0;
   size_t m_capacity = 0;
-  Array<Node*> m_buckets;
+  Node** m_buckets = nullptr;
+  // Buckets before m_migrated were already moved to m_buckets, m_oldCapacity is 0 when not resizing
+  Node** m_oldBuckets = nullptr;
+  size_t m_oldCapacity = 0;
+  size_t m_migrated = 0;
+  bool m_incremental = false;
+  size_t m_rehashes = 0;
+  [[no_unique_address]] A m_allocator;
 };
 
 } /* namespace mrt */
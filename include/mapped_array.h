@@ -0,0 +1,225 @@
+#ifndef _MRT_COLLECTIONS_MAPPED_ARRAY_H_
+#define _MRT_COLLECTIONS_MAPPED_ARRAY_H_ 1
+
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <mrt/utils/constants.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/mapped_file.h>
+#include <mrt/allocator.h>
+#include <mrt/array_view.h>
+#include <mrt/array.h>
+
+namespace mrt {
+
+/*
+  Array of trivially copyable elements backed by a file written with Array::save().
+  Opening maps the file instead of reading it, pages are loaded by the OS on first access.
+  ReadOnly maps pages read-only, CopyOnWrite allows writes through mutableData() that stay private
+  to this mapping and never reach the file (use save() to persist them).
+*/
+template <Mappable T>
+class MappedArray {
+ public:
+  enum class Mode {
+    ReadOnly,
+    CopyOnWrite,
+  };
+
+ public:
+  inline MappedArray() {}
+
+  inline MappedArray(const char* path, Mode mode = Mode::ReadOnly) : m_mode(mode) {
+    map(path);
+  }
+
+  MappedArray(const MappedArray&) = delete;
+  MappedArray& operator=(const MappedArray&) = delete;
+
+  inline MappedArray(MappedArray&& rhs) noexcept {
+    take(rhs);
+  }
+
+  inline MappedArray& operator=(MappedArray&& rhs) noexcept {
+    if (this == &rhs) return *this;
+    unmap();
+    take(rhs);
+    return *this;
+  }
+
+  inline virtual ~MappedArray() {
+    unmap();
+  }
+
+  inline size_t size() const { return m_size; }
+  inline const T* data() const { return m_data; }
+  inline Mode mode() const { return m_mode; }
+
+  // Writable pointer to the elements, only in CopyOnWrite mode
+  inline T* mutableData() {
+    if (m_mode != Mode::CopyOnWrite) throw MappedFileException("Array is mapped read-only");
+    return m_data;
+  }
+
+  inline const T* begin() const { return m_data; }
+  inline const T* end() const { return m_data + m_size; }
+
+  inline const T* cbegin() const { return m_data; }
+  inline const T* cend() const { return m_data + m_size; }
+
+  inline const T& operator[](size_t index) const {
+    return m_data[index];
+  }
+
+  inline const T& get(size_t index, const T& defaultValue) const {
+    return index < m_size ? m_data[index] : defaultValue;
+  }
+
+  inline ArrayView<T> view(size_t start = 0, size_t end = nidx) const {
+    return ArrayView<T>(m_data, m_size).slice(start, end);
+  }
+
+  inline bool contains(const T& value) const {
+    return view().contains(value);
+  }
+
+  inline Array<size_t> find(const T& value, size_t startIdx = 0) const {
+    return view().find(value, startIdx);
+  }
+
+  inline size_t lfind(const T& value, size_t startIdx = 0) const {
+    return view().lfind(value, startIdx);
+  }
+
+  // Searches backwards from startIdx (inclusive), or from the last element if startIdx is 0
+  inline size_t rfind(const T& value, size_t startIdx = 0) const {
+    return view().rfind(value, startIdx);
+  }
+
+  // File has to be sorted ascending, see ArrayView::binarySearch
+  inline size_t binarySearch(const T& value) const requires Ordered<T> {
+    return view().binarySearch(value);
+  }
+
+  inline size_t lowerBound(const T& value) const requires Ordered<T> {
+    return view().lowerBound(value);
+  }
+
+  inline bool isSorted() const requires Ordered<T> {
+    for (size_t i = 1; i < m_size; i++) {
+      if (m_data[i] < m_data[i-1]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <Consumer<const T&> F>
+  inline void foreach(F f) const {
+    view().foreach(f);
+  }
+
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduce(F reducer, R startValue = {}) const {
+    return view().reduce(reducer, startValue);
+  }
+
+  template <Predicate<const T&> F>
+  inline Array<T> filter(F pred) const {
+    return view().filter(pred).collect();
+  }
+
+  template <typename R = T, Callable<R, const T&> F>
+  inline Array<R> map(F mapper) const {
+    Array<R> result = Array<R>::empty(m_size + 1);
+    for (size_t i = 0; i < m_size; i++) {
+      result.append(mapper(m_data[i]));
+    }
+    return result;
+  }
+
+  // Copies elements into memory owned by an Array
+  template <Allocator A = DefaultAllocator>
+  inline Array<T, A> toArray(const A& allocator = A()) const {
+    return Array<T, A>(view(), allocator);
+  }
+
+  // Writes current contents, including copy-on-write changes, to path
+  inline void save(const char* path) const {
+    mapped::save(path, m_data, m_size);
+  }
+
+  inline bool operator==(ArrayView<T> rhs) const {
+    return view() == rhs;
+  }
+
+  inline bool operator!=(ArrayView<T> rhs) const {
+    return view() != rhs;
+  }
+
+ private:
+  inline void map(const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) throw MappedFileException("Can't open file");
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || (size_t) info.st_size < mapped::DATA_OFFSET) {
+      ::close(fd);
+      throw MappedFileException("Not an array file");
+    }
+
+    // Private mapping in both modes, so writes of CopyOnWrite mode never reach the file
+    int protection = m_mode == Mode::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* mapping = ::mmap(nullptr, info.st_size, protection, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) throw MappedFileException("Can't map file");
+
+    mapped::Header header;
+    std::memcpy(&header, mapping, sizeof(header));
+    if (!mapped::isValid<T>(header, info.st_size)) {
+      ::munmap(mapping, info.st_size);
+      throw MappedFileException("File doesn't hold an array of this type");
+    }
+
+    m_mapping = mapping;
+    m_mappingSize = info.st_size;
+    m_data = reinterpret_cast<T*>(static_cast<char*>(mapping) + mapped::DATA_OFFSET);
+    m_size = header.count;
+  }
+
+  inline void unmap() {
+    if (m_mapping) {
+      ::munmap(m_mapping, m_mappingSize);
+      m_mapping = nullptr;
+      m_mappingSize = 0;
+      m_data = nullptr;
+      m_size = 0;
+    }
+  }
+
+  inline void take(MappedArray& rhs) {
+    m_mapping = rhs.m_mapping;
+    m_mappingSize = rhs.m_mappingSize;
+    m_data = rhs.m_data;
+    m_size = rhs.m_size;
+    m_mode = rhs.m_mode;
+    rhs.m_mapping = nullptr;
+    rhs.m_mappingSize = 0;
+    rhs.m_data = nullptr;
+    rhs.m_size = 0;
+  }
+
+ private:
+  void* m_mapping = nullptr;
+  size_t m_mappingSize = 0;
+  T* m_data = nullptr;
+  size_t m_size = 0;
+  Mode m_mode = Mode::ReadOnly;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_MAPPED_ARRAY_H_ */
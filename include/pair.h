@@ -13,7 +13,7 @@ struct Pair {
   inline Pair(const T1& _1) : _1(_1) {}
   inline Pair(const T1& _1, const T2& _2) : _1(_1), _2(_2) {}
 
-  virtual inline ~Pair() {}
+  inline ~Pair() = default;
 };
 
 } /* namespace mrt */
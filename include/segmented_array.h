@@ -0,0 +1,353 @@
+#ifndef _MRT_COLLECTIONS_SEGMENTED_ARRAY_H_
+#define _MRT_COLLECTIONS_SEGMENTED_ARRAY_H_ 1
+
+#include <initializer_list>
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <cstdlib>
+#include <new>
+#include <bit>
+#include <mrt/utils/constants.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
+#include <mrt/array_view.h>
+#include <mrt/array.h>
+#include <mrt/view.h>
+
+namespace mrt {
+
+/*
+  Array made of segments that double in size: segment k holds FIRST_SEGMENT << k elements.
+  Growing allocates one more segment and never moves existing elements, so pointers and references
+  stay valid until the element is removed. Element i lives in segment log2(i + FIRST_SEGMENT) - FIRST_BITS,
+  which is one bit scan, and the segment directory is a fixed array, so indexing is O(1).
+*/
+template <typename T, Allocator A = DefaultAllocator>
+class SegmentedArray {
+ public:
+  constexpr static size_t FIRST_BITS = 4;
+  constexpr static size_t FIRST_SEGMENT = (size_t) 1 << FIRST_BITS;
+  constexpr static size_t MAX_SEGMENTS = sizeof(size_t) * 8 - FIRST_BITS;
+
+  // Walks a segment at a time, so advancing is a pointer increment except at segment ends
+  class Iterator {
+   public:
+    inline Iterator(SegmentedArray* array, size_t index) : m_array(array), m_index(index) {
+      if (index < array->m_size) locate();
+    }
+
+    inline size_t index() const { return m_index; }
+
+    inline T& operator*() const { return *m_current; }
+
+    inline bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index; }
+    inline bool operator!=(const Iterator& rhs) const { return m_index != rhs.m_index; }
+
+    inline Iterator& operator++() {
+      m_index++;
+      if (++m_current == m_segmentEnd && m_index < m_array->m_size) locate();
+      return *this;
+    }
+
+   private:
+    inline void locate() {
+      size_t segment = segmentOf(m_index);
+      m_current = m_array->m_segments[segment] + offsetOf(m_index, segment);
+      m_segmentEnd = m_array->m_segments[segment] + segmentSize(segment);
+    }
+
+   private:
+    SegmentedArray* m_array;
+    size_t m_index;
+    T* m_current = nullptr;
+    T* m_segmentEnd = nullptr;
+  };
+
+ public:
+  inline SegmentedArray() {}
+
+  inline SegmentedArray(const A& allocator) : m_allocator(allocator) {}
+
+  inline SegmentedArray(const SegmentedArray& rhs) : m_allocator(rhs.m_allocator) {
+    operator=(rhs);
+  }
+
+  inline SegmentedArray(SegmentedArray&& rhs) noexcept : m_allocator(rhs.m_allocator) {
+    take(rhs);
+  }
+
+  inline SegmentedArray(std::initializer_list<T> il, const A& allocator = A()) : m_allocator(allocator) {
+    reserve(il.size());
+    for (auto& x : il) {
+      append(x);
+    }
+  }
+
+  inline virtual ~SegmentedArray() {
+    clear();
+  }
+
+  inline size_t size() const { return m_size; }
+  inline bool isEmpty() const { return m_size == 0; }
+  inline size_t capacity() const { return capacityOf(m_segmentCount); }
+  inline size_t segments() const { return m_segmentCount; }
+  inline const A& allocator() const { return m_allocator; }
+
+  inline size_t memoryUsage() const {
+    return capacity() * sizeof(T);
+  }
+
+  // Growing never reallocates, reallocations stay 0
+  inline MemoryStats stats() const {
+    MemoryStats result;
+    result.allocated = memoryUsage();
+    result.live = m_size * sizeof(T);
+    return result;
+  }
+
+  inline Iterator begin() { return Iterator(this, 0); }
+  inline Iterator end() { return Iterator(this, m_size); }
+
+  // Elements of segment k, contiguous in memory
+  inline ArrayView<T> segment(size_t k) const {
+    size_t start = capacityOf(k);
+    if (start >= m_size) return ArrayView<T>();
+    size_t count = m_size - start < segmentSize(k) ? m_size - start : segmentSize(k);
+    return ArrayView<T>(m_segments[k], count);
+  }
+
+  template <typename... Args>
+  inline T& emplace(Args&&... args) {
+    if (m_size == capacity()) {
+      addSegment();
+    }
+    size_t segment = segmentOf(m_size);
+    T* element = new (m_segments[segment] + offsetOf(m_size, segment)) T(std::forward<Args>(args)...);
+    m_size++;
+    return *element;
+  }
+
+  inline void append(const T& element) {
+    emplace(element);
+  }
+
+  inline void append(T&& element) {
+    emplace(std::move(element));
+  }
+
+  inline T pop() {
+    T& last = (*this)[m_size - 1];
+    T value = std::move(last);
+    last.~T();
+    m_size--;
+    return value;
+  }
+
+  // Segments are only added, capacity stays until clear()
+  inline void reserve(size_t size) {
+    while (capacity() < size) {
+      addSegment();
+    }
+  }
+
+  inline void clear() {
+    for (size_t k = 0; k < m_segmentCount; k++) {
+      ArrayView<T> elements = segment(k);
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (size_t i = 0; i < elements.size(); i++) {
+          m_segments[k][i].~T();
+        }
+      }
+      m_allocator.deallocate(m_segments[k], segmentSize(k) * sizeof(T), alignof(T));
+      m_segments[k] = nullptr;
+    }
+    m_segmentCount = 0;
+    m_size = 0;
+  }
+
+  inline bool contains(const T& value) const {
+    return lfind(value) != nidx;
+  }
+
+  // Segments are searched as ArrayViews, so arithmetic types get the SIMD search
+  inline size_t lfind(const T& value, size_t startIdx = 0) const {
+    if (startIdx >= m_size) return nidx;
+    for (size_t k = segmentOf(startIdx); k < m_segmentCount; k++) {
+      size_t start = capacityOf(k);
+      ArrayView<T> elements = segment(k);
+      size_t index = elements.lfind(value, startIdx > start ? startIdx - start : 0);
+      if (index != nidx) return start + index;
+    }
+    return nidx;
+  }
+
+  // Searches backwards from startIdx (inclusive), or from the last element if startIdx is 0
+  inline size_t rfind(const T& value, size_t startIdx = 0) const {
+    if (!m_size) return nidx;
+    size_t last = (startIdx && startIdx < m_size) ? startIdx : m_size - 1;
+    for (size_t k = segmentOf(last) + 1; k > 0; k--) {
+      size_t start = capacityOf(k - 1);
+      ArrayView<T> elements = segment(k - 1).take(last - start + 1);
+      size_t index = elements.rfind(value);
+      if (index != nidx) return start + index;
+    }
+    return nidx;
+  }
+
+  inline Array<size_t, A> find(const T& value, size_t startIdx = 0) const {
+    Array<size_t, A> indexes(m_allocator);
+    for (size_t i = lfind(value, startIdx); i != nidx; i = lfind(value, i + 1)) {
+      indexes.append(i);
+    }
+    return indexes;
+  }
+
+  // Lazy single-pass pipeline over the elements, see View
+  inline auto view() const {
+    return makeView<T>([this](auto&& sink) {
+      for (size_t k = 0; k < m_segmentCount; k++) {
+        ArrayView<T> elements = segment(k);
+        for (size_t i = 0; i < elements.size(); i++) {
+          if (!sink(elements[i])) return;
+        }
+      }
+    });
+  }
+
+  template <Consumer<const T&> F>
+  inline void foreach(F f) const {
+    for (size_t k = 0; k < m_segmentCount; k++) {
+      segment(k).foreach(f);
+    }
+  }
+
+  template <Predicate<const T&> F>
+  inline SegmentedArray filter(F pred) const {
+    SegmentedArray result(m_allocator);
+    foreach([&result, &pred](const T& value) {
+      if (pred(value)) result.append(value);
+    });
+    return result;
+  }
+
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduce(F reducer, R startValue = {}) const {
+    R result = startValue;
+    for (size_t k = 0; k < m_segmentCount; k++) {
+      result = segment(k).template reduce<R>(reducer, result);
+    }
+    return result;
+  }
+
+  template <typename R = T, Callable<R, const T&> F>
+  inline SegmentedArray<R, A> map(F mapper) const {
+    SegmentedArray<R, A> result(m_allocator);
+    result.reserve(m_size);
+    foreach([&result, &mapper](const T& value) { result.append(mapper(value)); });
+    return result;
+  }
+
+  inline const T& get(size_t index, const T& defaultValue) const {
+    return index < m_size ? (*this)[index] : defaultValue;
+  }
+
+  inline T& operator[](size_t index) {
+    size_t segment = segmentOf(index);
+    return m_segments[segment][offsetOf(index, segment)];
+  }
+
+  inline const T& operator[](size_t index) const {
+    size_t segment = segmentOf(index);
+    return m_segments[segment][offsetOf(index, segment)];
+  }
+
+  inline SegmentedArray& operator=(const SegmentedArray& rhs) {
+    if (this == &rhs) return *this;
+    clear();
+    reserve(rhs.m_size);
+    rhs.foreach([this](const T& value) { append(value); });
+    return *this;
+  }
+
+  // Allocates, and so can throw, when allocators differ
+  inline SegmentedArray& operator=(SegmentedArray&& rhs) {
+    if (this == &rhs) return *this;
+    clear();
+    if (m_allocator == rhs.m_allocator) {
+      take(rhs);
+    } else {
+      // Segments can't change hands between allocators, elements are moved instead
+      reserve(rhs.m_size);
+      for (size_t i = 0; i < rhs.m_size; i++) {
+        append(std::move(rhs[i]));
+      }
+      rhs.clear();
+    }
+    return *this;
+  }
+
+  inline bool operator==(const SegmentedArray& rhs) const {
+    if (m_size != rhs.m_size) return false;
+    // Equal sizes fill the same segments
+    for (size_t k = 0; k < m_segmentCount && k < rhs.m_segmentCount; k++) {
+      if (segment(k) != rhs.segment(k)) return false;
+    }
+    return true;
+  }
+
+  inline bool operator!=(const SegmentedArray& rhs) const {
+    return !operator==(rhs);
+  }
+
+  inline SegmentedArray& operator+=(const T& rhs) {
+    append(rhs);
+    return *this;
+  }
+
+ private:
+  inline static size_t segmentSize(size_t k) {
+    return FIRST_SEGMENT << k;
+  }
+
+  // Elements held by the first k segments
+  inline static size_t capacityOf(size_t k) {
+    return (FIRST_SEGMENT << k) - FIRST_SEGMENT;
+  }
+
+  inline static size_t segmentOf(size_t index) {
+    return std::bit_width(index + FIRST_SEGMENT) - 1 - FIRST_BITS;
+  }
+
+  inline static size_t offsetOf(size_t index, size_t segment) {
+    return index - capacityOf(segment);
+  }
+
+  inline void addSegment() {
+    size_t k = m_segmentCount;
+    m_segments[k] = static_cast<T*>(m_allocator.allocate(segmentSize(k) * sizeof(T), alignof(T)));
+    m_segmentCount++;
+  }
+
+  inline void take(SegmentedArray& rhs) {
+    for (size_t k = 0; k < rhs.m_segmentCount; k++) {
+      m_segments[k] = rhs.m_segments[k];
+      rhs.m_segments[k] = nullptr;
+    }
+    m_segmentCount = rhs.m_segmentCount;
+    m_size = rhs.m_size;
+    rhs.m_segmentCount = 0;
+    rhs.m_size = 0;
+  }
+
+ private:
+  T* m_segments[MAX_SEGMENTS] = {};
+  size_t m_segmentCount = 0;
+  size_t m_size = 0;
+  [[no_unique_address]] A m_allocator;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_SEGMENTED_ARRAY_H_ */
@@ -0,0 +1,393 @@
+#ifndef _MRT_COLLECTIONS_SERIALIZATION_H_
+#define _MRT_COLLECTIONS_SERIALIZATION_H_ 1
+
+#include <type_traits>
+#include <exception>
+#include <concepts>
+#include <utility>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <bit>
+#include <unistd.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/allocator.h>
+#include <mrt/array_view.h>
+#include <mrt/array.h>
+#include <mrt/pair.h>
+
+namespace mrt {
+
+template <typename T, Allocator A>
+class List;
+
+template <typename K, typename V, Allocator A>
+class Map;
+
+template <typename T>
+class BaseString;
+
+struct SerializationException : public std::exception {
+  inline SerializationException(const char* reason) : m_reason(reason) {}
+
+  inline const char* what() const noexcept override {
+    return m_reason;
+  }
+
+ private:
+  const char* m_reason;
+};
+
+/*
+  Binary encoding:
+    stream   - 'M' 'R' 'T' 'S', format version, byte order flag, 2 reserved bytes, then values
+    sizes    - unsigned LEB128 varint
+    raw      - trivially copyable values (numbers, enums, PODs) as their bytes in host byte order,
+               arrays of them as size + one bulk copy
+    strings  - size + characters, without the terminator
+    others   - size + elements (Array, List), size + key/value pairs (Map), fields in order (Pair)
+  Other types are supported by overloading encode(BinaryWriter&, const T&) and decode(BinaryReader&, T&)
+  in the type's namespace.
+*/
+namespace serialization {
+
+constexpr uint8_t MAGIC[4] = {'M', 'R', 'T', 'S'};
+constexpr uint8_t VERSION = 1;
+constexpr uint8_t LITTLE_ENDIAN_FLAG = 1;
+constexpr size_t HEADER_SIZE = 8;
+
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+// Upper bound for reserve() on a decoded size, so a corrupted size can't allocate everything upfront
+constexpr size_t MAX_RESERVE = 64 * 1024;
+
+inline uint8_t byteOrder() {
+  return std::endian::native == std::endian::little ? LITTLE_ENDIAN_FLAG : 0;
+}
+
+} /* namespace serialization */
+
+// Pointers are trivially copyable too, but their bytes mean nothing in another process
+template <typename T>
+concept RawEncodable = std::is_trivially_copyable_v<T> and !std::is_pointer_v<T> and !std::is_member_pointer_v<T>;
+
+/*
+  Encodes values into an in-memory buffer, or streams them to a file descriptor in BUFFER_SIZE blocks.
+  Writing to fd only happens in flush() and when the buffer fills up, call flush() to catch write errors,
+  the destructor flushes too but has to ignore them.
+*/
+class BinaryWriter {
+ public:
+  inline BinaryWriter() {
+    writeHeader();
+  }
+
+  inline explicit BinaryWriter(int fd) : m_fd(fd) {
+    m_buffer.reserve(serialization::BUFFER_SIZE + 1);
+    writeHeader();
+  }
+
+  BinaryWriter(const BinaryWriter&) = delete;
+  BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+  inline virtual ~BinaryWriter() {
+    try {
+      flush();
+    } catch (...) {}
+  }
+
+  // Encoded bytes, not yet flushed ones when writing to fd
+  inline const Array<uint8_t>& buffer() const {
+    return m_buffer;
+  }
+
+  template <typename T>
+  inline BinaryWriter& write(const T& value) {
+    encode(*this, value);
+    return *this;
+  }
+
+  inline void writeBytes(const void* data, size_t size) {
+    if (m_fd >= 0 && m_buffer.size() + size > serialization::BUFFER_SIZE) {
+      flush();
+      // Large payloads skip the buffer
+      if (size >= serialization::BUFFER_SIZE) {
+        writeToFd(data, size);
+        return;
+      }
+    }
+    m_buffer += ArrayView<uint8_t>(static_cast<const uint8_t*>(data), size);
+  }
+
+  inline void writeSize(uint64_t size) {
+    uint8_t bytes[10];
+    size_t count = 0;
+    do {
+      bytes[count++] = (size & 0x7F) | (size >= 0x80 ? 0x80 : 0);
+      size >>= 7;
+    } while (size);
+    writeBytes(bytes, count);
+  }
+
+  inline void flush() {
+    if (m_fd < 0 || !m_buffer.size()) return;
+    writeToFd(m_buffer.data(), m_buffer.size());
+    m_buffer.remove(0, m_buffer.size());
+  }
+
+ private:
+  inline void writeHeader() {
+    uint8_t header[serialization::HEADER_SIZE] = {};
+    std::memcpy(header, serialization::MAGIC, sizeof(serialization::MAGIC));
+    header[4] = serialization::VERSION;
+    header[5] = serialization::byteOrder();
+    writeBytes(header, sizeof(header));
+  }
+
+  inline void writeToFd(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    while (size) {
+      ssize_t written = ::write(m_fd, bytes, size);
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        throw SerializationException("Can't write to file");
+      }
+      bytes += written;
+      size -= written;
+    }
+  }
+
+ private:
+  int m_fd = -1;
+  Array<uint8_t> m_buffer;
+};
+
+/*
+  Decodes values one at a time from memory (not copied, has to outlive the reader) or from a file
+  descriptor, which is read in BUFFER_SIZE blocks as values are requested. Values can be decoded
+  while the rest of the stream is still being written. Throws SerializationException on truncated
+  or malformed input.
+*/
+class BinaryReader {
+ public:
+  inline BinaryReader(const void* data, size_t size)
+    : m_data(static_cast<const uint8_t*>(data)), m_end(size) {
+    readHeader();
+  }
+
+  inline BinaryReader(const Array<uint8_t>& data) : BinaryReader(data.data(), data.size()) {}
+
+  inline explicit BinaryReader(int fd) : m_fd(fd), m_block(new uint8_t[serialization::BUFFER_SIZE]) {
+    m_data = m_block.get();
+    readHeader();
+  }
+
+  BinaryReader(const BinaryReader&) = delete;
+  BinaryReader& operator=(const BinaryReader&) = delete;
+
+  inline virtual ~BinaryReader() {}
+
+  template <typename T>
+  inline T read() {
+    T value;
+    decode(*this, value);
+    return value;
+  }
+
+  template <typename T>
+  inline BinaryReader& read(T& value) {
+    decode(*this, value);
+    return *this;
+  }
+
+  // True once every value was read, for fd it means the writer closed its end
+  inline bool atEnd() {
+    return m_position == m_end && !refill();
+  }
+
+  inline void readBytes(void* data, size_t size) {
+    uint8_t* out = static_cast<uint8_t*>(data);
+    while (size) {
+      if (m_position == m_end) {
+        // Large payloads are read straight into place
+        if (m_fd >= 0 && size >= serialization::BUFFER_SIZE) {
+          readFromFd(out, size);
+          return;
+        }
+        if (!refill()) throw SerializationException("Unexpected end of input");
+      }
+      size_t available = m_end - m_position;
+      size_t count = available < size ? available : size;
+      std::memcpy(out, m_data + m_position, count);
+      m_position += count;
+      out += count;
+      size -= count;
+    }
+  }
+
+  inline uint64_t readSize() {
+    uint64_t size = 0;
+    for (size_t shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      readBytes(&byte, 1);
+      size |= (uint64_t) (byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return size;
+    }
+    throw SerializationException("Malformed size");
+  }
+
+ private:
+  inline void readHeader() {
+    uint8_t header[serialization::HEADER_SIZE];
+    readBytes(header, sizeof(header));
+    if (std::memcmp(header, serialization::MAGIC, sizeof(serialization::MAGIC)) != 0) {
+      throw SerializationException("Not an mrt stream");
+    }
+    if (header[4] != serialization::VERSION) throw SerializationException("Unsupported format version");
+    if (header[5] != serialization::byteOrder()) throw SerializationException("Stream has different byte order");
+  }
+
+  inline bool refill() {
+    if (m_fd < 0) return false;
+    m_position = 0;
+    m_end = 0;
+    while (true) {
+      ssize_t count = ::read(m_fd, m_block.get(), serialization::BUFFER_SIZE);
+      if (count < 0 && errno == EINTR) continue;
+      if (count < 0) throw SerializationException("Can't read from file");
+      m_end = count;
+      return count > 0;
+    }
+  }
+
+  inline void readFromFd(uint8_t* out, size_t size) {
+    while (size) {
+      ssize_t count = ::read(m_fd, out, size);
+      if (count < 0 && errno == EINTR) continue;
+      if (count < 0) throw SerializationException("Can't read from file");
+      if (count == 0) throw SerializationException("Unexpected end of input");
+      out += count;
+      size -= count;
+    }
+  }
+
+ private:
+  int m_fd = -1;
+  std::unique_ptr<uint8_t[]> m_block;
+  const uint8_t* m_data = nullptr;
+  size_t m_position = 0;
+  size_t m_end = 0;
+};
+
+template <RawEncodable T>
+inline void encode(BinaryWriter& writer, const T& value) {
+  writer.writeBytes(&value, sizeof(T));
+}
+
+template <RawEncodable T>
+inline void decode(BinaryReader& reader, T& value) {
+  reader.readBytes(&value, sizeof(T));
+}
+
+// Trivially copyable pairs are written as raw bytes by the overloads above, padding included
+template <typename T1, typename T2>
+requires (!RawEncodable<Pair<T1, T2>>)
+inline void encode(BinaryWriter& writer, const Pair<T1, T2>& value) {
+  writer.write(value._1);
+  writer.write(value._2);
+}
+
+template <typename T1, typename T2>
+requires (!RawEncodable<Pair<T1, T2>>)
+inline void decode(BinaryReader& reader, Pair<T1, T2>& value) {
+  reader.read(value._1);
+  reader.read(value._2);
+}
+
+template <typename T, Allocator A, GrowthPolicy G>
+inline void encode(BinaryWriter& writer, const Array<T, A, G>& value) {
+  writer.writeSize(value.size());
+  if constexpr (RawEncodable<T>) {
+    writer.writeBytes(value.data(), value.size() * sizeof(T));
+  } else {
+    for (size_t i = 0; i < value.size(); i++) {
+      writer.write(value[i]);
+    }
+  }
+}
+
+template <typename T, Allocator A, GrowthPolicy G>
+inline void decode(BinaryReader& reader, Array<T, A, G>& value) {
+  uint64_t size = reader.readSize();
+  value.clear();
+
+  if constexpr (RawEncodable<T>) {
+    // Bounded blocks, so the array only grows as far as the input actually goes.
+    // Runs at least once, so an empty array still gets its buffer
+    constexpr size_t BLOCK = serialization::BUFFER_SIZE / sizeof(T) ? serialization::BUFFER_SIZE / sizeof(T) : 1;
+    do {
+      size_t count = size < BLOCK ? size : BLOCK;
+      reader.readBytes(value.appendUninitialized(count), count * sizeof(T));
+      size -= count;
+    } while (size);
+  } else {
+    value.reserve(size < serialization::MAX_RESERVE ? size + 1 : serialization::MAX_RESERVE);
+    // Decoded in place, elements without a move constructor would be copied otherwise
+    for (uint64_t i = 0; i < size; i++) {
+      reader.read(value.emplace());
+    }
+  }
+}
+
+template <typename T>
+inline void encode(BinaryWriter& writer, const BaseString<T>& value) {
+  writer.writeSize(value.size());
+  writer.writeBytes(value.data(), value.size() * sizeof(T));
+}
+
+template <typename T>
+inline void decode(BinaryReader& reader, BaseString<T>& value) {
+  decode(reader, static_cast<Array<T>&>(value));
+  // Array always keeps a spare slot past the last element, the terminator goes there
+  value.data()[value.size()] = 0;
+}
+
+template <typename T, Allocator A>
+inline void encode(BinaryWriter& writer, const List<T, A>& value) {
+  writer.writeSize(value.size());
+  value.view().foreach([&writer](const T& element) { writer.write(element); });
+}
+
+template <typename T, Allocator A>
+inline void decode(BinaryReader& reader, List<T, A>& value) {
+  uint64_t size = reader.readSize();
+  value.clear();
+  for (uint64_t i = 0; i < size; i++) {
+    value.append(reader.read<T>());
+  }
+}
+
+template <typename K, typename V, Allocator A>
+inline void encode(BinaryWriter& writer, const Map<K, V, A>& value) {
+  writer.writeSize(value.size());
+  value.view().foreach([&writer](const Pair<K, V>& item) {
+    writer.write(item._1);
+    writer.write(item._2);
+  });
+}
+
+template <typename K, typename V, Allocator A>
+inline void decode(BinaryReader& reader, Map<K, V, A>& value) {
+  uint64_t size = reader.readSize();
+  value.clear();
+  for (uint64_t i = 0; i < size; i++) {
+    K key = reader.read<K>();
+    value.set(key, reader.read<V>());
+  }
+}
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_SERIALIZATION_H_ */
@@ -0,0 +1,200 @@
+#ifndef _MRT_COLLECTIONS_SMALL_ARRAY_H_
+#define _MRT_COLLECTIONS_SMALL_ARRAY_H_ 1
+
+#include <initializer_list>
+#include <functional>
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <cstdlib>
+#include <mrt/utils/concepts.h>
+#include <mrt/sort/merge.h>
+#include <mrt/sort.h>
+#include <mrt/array.h>
+
+namespace mrt {
+
+/*
+  Array that keeps first N elements in inline storage and moves them to the heap
+  only when N is exceeded. Can be used everywhere Array is expected.
+*/
+template <typename T, size_t N = 8>
+class SmallArray : public Array<T> {
+ public:
+  // Array growth keeps one slot spare, so one more slot is reserved to fit N elements
+  constexpr static size_t INLINE_SIZE = N + 1;
+
+ public:
+  inline SmallArray() : Array<T>(reinterpret_cast<T*>(m_inline), INLINE_SIZE) {}
+
+  inline SmallArray(const SmallArray& rhs) : Array<T>(reinterpret_cast<T*>(m_inline), INLINE_SIZE) {
+    appendAll(rhs);
+  }
+
+  inline SmallArray(const Array<T>& rhs) : Array<T>(reinterpret_cast<T*>(m_inline), INLINE_SIZE) {
+    appendAll(rhs);
+  }
+
+  // Never allocates: inline elements fit in inline storage, a heap buffer is taken over
+  inline SmallArray(SmallArray&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) : Array<T>(reinterpret_cast<T*>(m_inline), INLINE_SIZE) {
+    if (rhs.isInStorage()) {
+      moveAll(rhs);
+    } else {
+      this->Array<T>::operator=(std::move(rhs));
+      rhs.clear();
+    }
+  }
+
+  // Takes the heap buffer of rhs, elements that fit inline are moved there instead
+  inline SmallArray(Array<T>&& rhs) : Array<T>(reinterpret_cast<T*>(m_inline), INLINE_SIZE) {
+    if (rhs.size() < INLINE_SIZE) {
+      for (size_t i = 0; i < rhs.size(); i++) {
+        this->append(std::move(rhs[i]));
+      }
+      rhs.clear();
+    } else {
+      this->Array<T>::operator=(std::move(rhs));
+    }
+  }
+
+  inline SmallArray(std::initializer_list<T> il) : Array<T>(reinterpret_cast<T*>(m_inline), INLINE_SIZE) {
+    this->reserve(il.size() + 1);
+    for (auto& x : il) {
+      this->append(x);
+    }
+  }
+
+  inline virtual ~SmallArray() {
+    this->clear();
+  }
+
+  static inline SmallArray empty(size_t size) {
+    SmallArray result;
+    result.reserve(size);
+    return result;
+  }
+
+  static inline SmallArray filled(size_t size, T element) {
+    SmallArray result;
+    result.reserve(size + 1);
+    for (size_t i = 0; i < size; i++) {
+      result.append(element);
+    }
+    return result;
+  }
+
+  inline bool isInline() const {
+    return this->isInStorage();
+  }
+
+  inline SmallArray slice(size_t start, size_t end = 0) const {
+    SmallArray result;
+    if (end == 0) {
+      end = start;
+      start = 0;
+    }
+    for (size_t i = start; i < end; i++) {
+      result.append((*this)[i]);
+    }
+    return result;
+  }
+
+  // Set operations reuse the hash and sorted paths of Array
+  inline SmallArray unique() const {
+    return SmallArray(Array<T>::unique());
+  }
+
+  inline void reverse() {
+    *this = reversed();
+  }
+
+  inline SmallArray reversed() {
+    SmallArray result;
+    for (size_t i = this->size(); i > 0; i--) {
+      result.append((*this)[i-1]);
+    }
+    return result;
+  }
+
+  template <Sorter<T, Array<T>> S = MergeSort, Comparator<T> F = Ascending<T>>
+  inline SmallArray sorted(F comparator = {}, S sorter = {}) {
+    SmallArray result = *this;
+    result.sort(comparator, sorter);
+    return result;
+  }
+
+  template <Predicate<const T&> F>
+  inline SmallArray filter(F pred) const {
+    SmallArray result;
+    for (size_t i = 0; i < this->size(); i++) {
+      if (pred((*this)[i])) {
+        result.append((*this)[i]);
+      }
+    }
+    return result;
+  }
+
+  template <typename R = T, Callable<R, const T&> F>
+  inline SmallArray<R, N> map(F mapper) const {
+    SmallArray<R, N> result;
+    for (size_t i = 0; i < this->size(); i++) {
+      result.append(mapper((*this)[i]));
+    }
+    return result;
+  }
+
+  inline SmallArray& operator=(const SmallArray& rhs) {
+    if (this == &rhs) return *this;
+    this->clear();
+    appendAll(rhs);
+    return *this;
+  }
+
+  inline SmallArray& operator=(SmallArray&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this == &rhs) return *this;
+    this->clear();
+    if (rhs.isInStorage()) {
+      moveAll(rhs);
+    } else {
+      this->Array<T>::operator=(std::move(rhs));
+      rhs.clear();
+    }
+    return *this;
+  }
+
+  inline SmallArray operator+(const Array<T>& rhs) const {
+    SmallArray result = *this;
+    result.appendAll(rhs);
+    return result;
+  }
+
+  inline SmallArray operator&(const Array<T>& rhs) const {
+    return SmallArray(Array<T>::operator&(rhs));
+  }
+
+  inline SmallArray operator|(const Array<T>& rhs) const {
+    return SmallArray(Array<T>::operator|(rhs));
+  }
+
+ private:
+  inline void appendAll(const Array<T>& rhs) {
+    this->reserve(rhs.size() + 1);
+    for (size_t i = 0; i < rhs.size(); i++) {
+      this->append(rhs[i]);
+    }
+  }
+
+  inline void moveAll(SmallArray& rhs) {
+    for (size_t i = 0; i < rhs.size(); i++) {
+      this->append(std::move(rhs[i]));
+    }
+    rhs.clear();
+  }
+
+ private:
+  alignas(T) unsigned char m_inline[INLINE_SIZE * sizeof(T)];
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_SMALL_ARRAY_H_ */
@@ -0,0 +1,314 @@
+#ifndef _MRT_COLLECTIONS_SOA_ARRAY_H_
+#define _MRT_COLLECTIONS_SOA_ARRAY_H_ 1
+
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <cstdlib>
+#include <tuple>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/memory.h>
+#include <mrt/array_view.h>
+#include <mrt/array.h>
+#include <mrt/sort/merge.h>
+#include <mrt/sort.h>
+
+namespace mrt {
+
+/*
+  Structure of arrays: row i is (column<0>()[i], column<1>()[i], ...), every field is kept
+  in its own Array, so a pass over one field only loads that field's memory and can be vectorized.
+  Rows are accessed through Row proxies, functional methods pass the fields as separate arguments.
+*/
+template <typename... Fields>
+class SoAArray {
+  static_assert(sizeof...(Fields) > 0, "SoAArray needs at least one field");
+
+ public:
+  template <size_t I>
+  using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  using Tuple = std::tuple<Fields...>;
+
+  constexpr static size_t FIELDS = sizeof...(Fields);
+
+  // References to the fields of one row, valid until the array is resized
+  class Row {
+   public:
+    inline Row(SoAArray* array, size_t index) : m_array(array), m_index(index) {}
+
+    inline size_t index() const { return m_index; }
+
+    template <size_t I>
+    inline Field<I>& get() const {
+      return std::get<I>(m_array->m_columns)[m_index];
+    }
+
+    inline operator Tuple() const {
+      return m_array->row(m_index);
+    }
+
+    inline const Row& operator=(const Tuple& values) const {
+      m_array->setRow(m_index, values, std::index_sequence_for<Fields...>());
+      return *this;
+    }
+
+   private:
+    SoAArray* m_array;
+    size_t m_index;
+  };
+
+  class ConstRow {
+   public:
+    inline ConstRow(const SoAArray* array, size_t index) : m_array(array), m_index(index) {}
+
+    inline size_t index() const { return m_index; }
+
+    template <size_t I>
+    inline const Field<I>& get() const {
+      return std::get<I>(m_array->m_columns)[m_index];
+    }
+
+    inline operator Tuple() const {
+      return m_array->row(m_index);
+    }
+
+   private:
+    const SoAArray* m_array;
+    size_t m_index;
+  };
+
+  class Iterator {
+   public:
+    inline Iterator(SoAArray* array, size_t index) : m_array(array), m_index(index) {}
+
+    inline Row operator*() const { return Row(m_array, m_index); }
+
+    inline bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index; }
+    inline bool operator!=(const Iterator& rhs) const { return m_index != rhs.m_index; }
+
+    inline Iterator& operator++() {
+      m_index++;
+      return *this;
+    }
+
+   private:
+    SoAArray* m_array;
+    size_t m_index;
+  };
+
+  class ConstIterator {
+   public:
+    inline ConstIterator(const SoAArray* array, size_t index) : m_array(array), m_index(index) {}
+
+    inline ConstRow operator*() const { return ConstRow(m_array, m_index); }
+
+    inline bool operator==(const ConstIterator& rhs) const { return m_index == rhs.m_index; }
+    inline bool operator!=(const ConstIterator& rhs) const { return m_index != rhs.m_index; }
+
+    inline ConstIterator& operator++() {
+      m_index++;
+      return *this;
+    }
+
+   private:
+    const SoAArray* m_array;
+    size_t m_index;
+  };
+
+ public:
+  inline SoAArray() {}
+
+  SoAArray(const SoAArray&) = default;
+  SoAArray(SoAArray&&) = default;
+
+  SoAArray& operator=(const SoAArray&) = default;
+  SoAArray& operator=(SoAArray&&) = default;
+
+  inline virtual ~SoAArray() {}
+
+  inline size_t size() const { return std::get<0>(m_columns).size(); }
+
+  inline size_t memoryUsage() const {
+    return std::apply([](const auto&... columns) { return (columns.memoryUsage() + ...); }, m_columns);
+  }
+
+  // Sum over all columns, every column reallocates separately
+  inline MemoryStats stats() const {
+    MemoryStats result;
+    std::apply([&result](const auto&... columns) { ((result += columns.stats()), ...); }, m_columns);
+    return result;
+  }
+
+  inline Iterator begin() { return Iterator(this, 0); }
+  inline Iterator end() { return Iterator(this, size()); }
+
+  inline ConstIterator cbegin() const { return ConstIterator(this, 0); }
+  inline ConstIterator cend() const { return ConstIterator(this, size()); }
+
+  // Contiguous elements of field I, for loops over a single field
+  template <size_t I>
+  inline ArrayView<Field<I>> column() const {
+    return std::get<I>(m_columns).view();
+  }
+
+  template <size_t I>
+  inline Field<I>* data() {
+    return std::get<I>(m_columns).data();
+  }
+
+  template <size_t I>
+  inline Field<I>& get(size_t index) {
+    return std::get<I>(m_columns)[index];
+  }
+
+  template <size_t I>
+  inline const Field<I>& get(size_t index) const {
+    return std::get<I>(m_columns)[index];
+  }
+
+  inline Tuple row(size_t index) const {
+    return std::apply([index](const auto&... columns) { return Tuple(columns[index]...); }, m_columns);
+  }
+
+  // One argument per field, every column gets one element or, if constructing one throws, none
+  template <typename... Args>
+  requires (sizeof...(Args) == sizeof...(Fields))
+  inline void emplace(Args&&... args) {
+    size_t count = size();
+    try {
+      emplaceColumns(std::index_sequence_for<Fields...>(), std::forward<Args>(args)...);
+    } catch (...) {
+      truncate(count, std::index_sequence_for<Fields...>());
+      throw;
+    }
+  }
+
+  inline void append(const Fields&... values) {
+    emplace(values...);
+  }
+
+  inline void append(const Tuple& values) {
+    std::apply([this](const auto&... fields) { emplace(fields...); }, values);
+  }
+
+  inline void remove(size_t index) {
+    std::apply([index](auto&... columns) { (columns.remove(index), ...); }, m_columns);
+  }
+
+  inline void reserve(size_t size) {
+    std::apply([size](auto&... columns) { (columns.reserve(size), ...); }, m_columns);
+  }
+
+  inline void clear() {
+    std::apply([](auto&... columns) { (columns.clear(), ...); }, m_columns);
+  }
+
+  inline Row operator[](size_t index) {
+    return Row(this, index);
+  }
+
+  inline ConstRow operator[](size_t index) const {
+    return ConstRow(this, index);
+  }
+
+  template <Consumer<const Fields&...> F>
+  inline void foreach(F f) const {
+    for (size_t i = 0, count = size(); i < count; i++) {
+      std::apply([&f, i](const auto&... columns) { f(columns[i]...); }, m_columns);
+    }
+  }
+
+  template <typename R, Callable<R, R, const Fields&...> F>
+  inline R reduce(F reducer, R startValue = {}) const {
+    R result = startValue;
+    for (size_t i = 0, count = size(); i < count; i++) {
+      result = std::apply([&reducer, &result, i](const auto&... columns) { return reducer(result, columns[i]...); }, m_columns);
+    }
+    return result;
+  }
+
+  // Rows for which pred(fields...) is true, in order
+  template <Predicate<const Fields&...> F>
+  inline SoAArray filter(F pred) const {
+    Array<size_t> rows;
+    for (size_t i = 0, count = size(); i < count; i++) {
+      if (std::apply([&pred, i](const auto&... columns) { return pred(columns[i]...); }, m_columns)) {
+        rows.append(i);
+      }
+    }
+
+    SoAArray result;
+    result.gather(*this, rows, std::index_sequence_for<Fields...>());
+    return result;
+  }
+
+  /*
+    Sorts rows by field I. Row indexes are sorted first, then every column is permuted once,
+    so wide rows aren't swapped element by element.
+  */
+  template <size_t I, Sorter<size_t, Array<size_t>> S = MergeSort, typename F = Ascending<Field<I>>>
+  requires Comparator<F, Field<I>>
+  inline void sortBy(F comparator = {}, S sorter = {}) {
+    Array<Field<I>>& keys = std::get<I>(m_columns);
+    Array<size_t> order = Array<size_t>::empty(size() + 1);
+    for (size_t i = 0, count = size(); i < count; i++) {
+      order.append(i);
+    }
+
+    sorter.sort([&keys, &comparator](size_t& lhs, size_t& rhs) {
+      return comparator(keys[lhs], keys[rhs]);
+    }, order);
+
+    SoAArray result;
+    result.gatherMoved(*this, order, std::index_sequence_for<Fields...>());
+    *this = std::move(result);
+  }
+
+  inline bool operator==(const SoAArray& rhs) const {
+    return m_columns == rhs.m_columns;
+  }
+
+  inline bool operator!=(const SoAArray& rhs) const {
+    return !operator==(rhs);
+  }
+
+ private:
+  template <size_t... Is, typename... Args>
+  inline void emplaceColumns(std::index_sequence<Is...>, Args&&... args) {
+    (std::get<Is>(m_columns).emplace(std::forward<Args>(args)), ...);
+  }
+
+  template <size_t... Is>
+  inline void truncate(size_t count, std::index_sequence<Is...>) {
+    ((std::get<Is>(m_columns).size() > count ? std::get<Is>(m_columns).remove(count, std::get<Is>(m_columns).size()) : void()), ...);
+  }
+
+  template <size_t... Is>
+  inline void setRow(size_t index, const Tuple& values, std::index_sequence<Is...>) {
+    ((std::get<Is>(m_columns)[index] = std::get<Is>(values)), ...);
+  }
+
+  template <size_t... Is>
+  inline void gather(const SoAArray& source, const Array<size_t>& rows, std::index_sequence<Is...>) {
+    reserve(rows.size() + 1);
+    for (size_t i = 0; i < rows.size(); i++) {
+      (std::get<Is>(m_columns).append(std::get<Is>(source.m_columns)[rows[i]]), ...);
+    }
+  }
+
+  template <size_t... Is>
+  inline void gatherMoved(SoAArray& source, const Array<size_t>& rows, std::index_sequence<Is...>) {
+    reserve(rows.size() + 1);
+    for (size_t i = 0; i < rows.size(); i++) {
+      (std::get<Is>(m_columns).append(std::move(std::get<Is>(source.m_columns)[rows[i]])), ...);
+    }
+  }
+
+ private:
+  std::tuple<Array<Fields>...> m_columns;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_SOA_ARRAY_H_ */
@@ -3,6 +3,7 @@
 
 #include <functional>
 #include <concepts>
+#include <mrt/utils/concepts.h>
 #include <mrt/collection.h>
 
 namespace mrt {
@@ -10,6 +11,9 @@ namespace mrt {
 template <typename T>
 using SortComparator = std::function<bool(T&, T&)>;
 
+template <typename F, typename T>
+concept Comparator = Predicate<F, T&, T&>;
+
 template <typename S, typename T, typename C>
 concept Sorter = Collection<C, T> and requires (S s, C& c, SortComparator<T> sc) {
   s.sort(sc, c);
@@ -25,6 +29,21 @@ inline bool asc(T lhs, T rhs) {
   return lhs < rhs;
 }
 
+// Default comparators of sort(), function objects are inlined where asc/desc pointers are not
+template <typename T>
+struct Ascending {
+  inline bool operator()(const T& lhs, const T& rhs) const {
+    return lhs < rhs;
+  }
+};
+
+template <typename T>
+struct Descending {
+  inline bool operator()(const T& lhs, const T& rhs) const {
+    return lhs > rhs;
+  }
+};
+
 } /* namespace mrt */
 
 #endif /* _MRT_COLLECTIONS_SORT_H_ */
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef _MRT_COLLECTIONS_SORT_MERGE_H_
 #define _MRT_COLLECTIONS_SORT_MERGE_H_ 1
 
+#include <type_traits>
+#include <utility>
 #include <mrt/sort.h>
 
 namespace mrt {
@@ -11,8 +13,8 @@ namespace mrt {
 */
 class MergeSort {
 
-  template <typename T, Collection<T> C>
-  void merge(C& collection, SortComparator<T> comparator, size_t start1, size_t end1, size_t start2, size_t end2, size_t dest) {
+  template <typename T, Collection<T> C, Comparator<T> F>
+  void merge(C& collection, F& comparator, size_t start1, size_t end1, size_t start2, size_t end2, size_t dest) {
     while (start1 < end1 && start2 < end2) {
       swap<T>(collection, dest++, comparator(collection[start1], collection[start2]) ? start1++ : start2++);
     }
@@ -26,15 +28,15 @@ class MergeSort {
     }
   }
 
-  template <typename T, Collection<T> C>
-  void sortSlice(C& collection, SortComparator<T> comparator, size_t start, size_t end, size_t dest) {
+  template <typename T, Collection<T> C, Comparator<T> F>
+  void sortSlice(C& collection, F& comparator, size_t start, size_t end, size_t dest) {
     size_t middle;
     
     if (end - start > 1) {
       middle = start + (end - start) / 2;
-      sort(collection, comparator, start, middle);
-      sort(collection, comparator, middle, end);
-      merge(collection, comparator, start, middle, middle, end, dest);
+      sort<T>(collection, comparator, start, middle);
+      sort<T>(collection, comparator, middle, end);
+      merge<T>(collection, comparator, start, middle, middle, end, dest);
     } else {
       while (start < end) {
         swap<T>(collection, start++, dest++);
@@ -42,20 +44,20 @@ class MergeSort {
     }
   }
 
-  template <typename T, Collection<T> C>
-  void sort(C& collection, SortComparator<T> comparator, size_t start, size_t end) {
+  template <typename T, Collection<T> C, Comparator<T> F>
+  void sort(C& collection, F& comparator, size_t start, size_t end) {
     size_t middle, n, dest;
 
     if (end - start > 1) {
       middle = start + (end - start) / 2;
       dest = start + end - middle;
-      sortSlice(collection, comparator, start, middle, dest);
+      sortSlice<T>(collection, comparator, start, middle, dest);
 
       while (dest - start > 2) {
         n = dest;
         dest = start + (n - start + 1) / 2;
-        sortSlice(collection, comparator, dest, n, start);
-        merge(collection, comparator, start, start + n - dest, n, end, dest);
+        sortSlice<T>(collection, comparator, dest, n, start);
+        merge<T>(collection, comparator, start, start + n - dest, n, end, dest);
       }
 
       for (size_t i = dest; i > start; i--) {
@@ -67,9 +69,11 @@ class MergeSort {
   }
 
  public:
-  template <typename T, Collection<T> C>
-  inline void sort(SortComparator<T> comparator, C& collection) {
-    sort(collection, comparator, 0, collection.size());
+  // Element type is taken from the collection, so comparator can be any callable
+  template <typename C, typename F, typename T = std::remove_reference_t<decltype(std::declval<C&>()[0])>>
+  requires Collection<C, T> and Comparator<F, T>
+  inline void sort(F comparator, C& collection) {
+    sort<T>(collection, comparator, 0, collection.size());
   }
 
 };
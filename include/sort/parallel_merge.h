@@ -0,0 +1,203 @@
+#ifndef _MRT_COLLECTIONS_SORT_PARALLEL_MERGE_H_
+#define _MRT_COLLECTIONS_SORT_PARALLEL_MERGE_H_ 1
+
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <cstdlib>
+#include <mrt/thread_pool.h>
+#include <mrt/sort.h>
+#include <mrt/array.h>
+
+namespace mrt {
+
+/*
+  Stable merge sort on a ThreadPool. The elements are split into one chunk per thread, chunks are
+  sorted concurrently, then runs are merged pairwise. Every merge is cut into pieces of about
+  n / threads outputs with merge-path partitioning: a binary search along the diagonal finds where
+  each piece starts in both runs, so pieces of one merge run on different threads.
+  Collections under the cutoff, or with one thread, are sorted on the calling thread.
+  Needs n extra elements of memory, non-contiguous collections are moved into an Array and back.
+*/
+class ParallelMergeSort {
+ public:
+  static constexpr size_t DEFAULT_CUTOFF = 1 << 14;
+
+  // threads = 0 uses every thread of pool
+  inline ParallelMergeSort(size_t threads = 0, size_t cutoff = DEFAULT_CUTOFF, ThreadPool& pool = ThreadPool::global())
+    : m_threads(threads ? threads : pool.threads()), m_cutoff(cutoff ? cutoff : 1), m_pool(&pool) {}
+
+  inline size_t threads() const { return m_threads; }
+  inline size_t cutoff() const { return m_cutoff; }
+
+  template <typename C, typename F, typename T = std::remove_reference_t<decltype(std::declval<C&>()[0])>>
+  requires Collection<C, T> and Comparator<F, T>
+  inline void sort(F comparator, C& collection) {
+    size_t size = collection.size();
+    if (size < 2) return;
+
+    if constexpr (requires { { collection.data() } -> std::same_as<T*>; }) {
+      sortElements(collection.data(), size, comparator);
+    } else {
+      Array<T> elements = Array<T>::empty(size + 1);
+      for (size_t i = 0; i < size; i++) {
+        elements.append(std::move(collection[i]));
+      }
+      sortElements(elements.data(), size, comparator);
+      for (size_t i = 0; i < size; i++) {
+        collection[i] = std::move(elements[i]);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t INSERTION_RUN = 32;
+
+  // Part of a merge: [start1, end1) and [start2, end2) of src go to dst from dest on
+  struct Piece {
+    size_t start1, end1, start2, end2;
+    size_t dest;
+  };
+
+  template <typename T, typename F>
+  inline void sortElements(T* data, size_t size, F& comparator) {
+    size_t chunks = m_threads < size / m_cutoff ? m_threads : size / m_cutoff;
+    if (chunks < 1) chunks = 1;
+
+    // Every slot of buffer holds a valid object, merges move-assign between data and buffer
+    Array<T> buffer = Array<T>::empty(size + 1);
+    for (size_t i = 0; i < size; i++) {
+      buffer.append(std::move(data[i]));
+    }
+    T* scratch = buffer.data();
+
+    // Chunks are sorted back into data
+    Array<size_t> bounds = Array<size_t>::empty(chunks + 2);
+    for (size_t i = 0; i <= chunks; i++) {
+      bounds.append(size * i / chunks);
+    }
+    if (chunks == 1) {
+      sortRun(scratch, data, 0, size, comparator);
+      return;
+    }
+    m_pool->parallelFor(chunks, 1, [scratch, data, &bounds, &comparator](size_t chunk, size_t) {
+      sortRun(scratch, data, bounds[chunk], bounds[chunk + 1], comparator);
+    });
+
+    T* src = data;
+    T* dst = scratch;
+    size_t pieceSize = (size + m_threads - 1) / m_threads;
+
+    while (bounds.size() > 2) {
+      Array<Piece> pieces;
+      Array<size_t> merged;
+      for (size_t r = 0; r + 1 < bounds.size(); r += 2) {
+        size_t start = bounds[r];
+        size_t middle = bounds[r + 1];
+        size_t end = r + 2 < bounds.size() ? bounds[r + 2] : middle;
+        merged.append(start);
+
+        // Split points are all found before merging starts, merges move from src
+        size_t i = 0;
+        for (size_t from = start; from < end; from += pieceSize) {
+          size_t to = from + pieceSize < end ? from + pieceSize : end;
+          size_t endI = coRank(src, start, middle, end, to - start, comparator);
+          size_t j = from - start - i;
+          size_t endJ = to - start - endI;
+          pieces.append(Piece{start + i, start + endI, middle + j, middle + endJ, from});
+          i = endI;
+        }
+      }
+      merged.append(size);
+
+      m_pool->parallelFor(pieces.size(), 1, [src, dst, &pieces, &comparator](size_t index, size_t) {
+        const Piece& piece = pieces[index];
+        merge(src, dst, piece.start1, piece.end1, piece.start2, piece.end2, piece.dest, comparator);
+      });
+
+      bounds = std::move(merged);
+      std::swap(src, dst);
+    }
+
+    if (src != data) {
+      m_pool->parallelFor(size, pieceSize, [src, data](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          data[i] = std::move(src[i]);
+        }
+      });
+    }
+  }
+
+  /*
+    Number of elements of [start, middle) among the first diagonal outputs of a stable merge with
+    [middle, end). Elements of the first run go before equal elements of the second one.
+  */
+  template <typename T, typename F>
+  inline static size_t coRank(T* src, size_t start, size_t middle, size_t end, size_t diagonal, F& comparator) {
+    size_t length1 = middle - start;
+    size_t length2 = end - middle;
+    size_t low = diagonal > length2 ? diagonal - length2 : 0;
+    size_t high = diagonal < length1 ? diagonal : length1;
+
+    while (low < high) {
+      size_t i = low + (high - low) / 2;
+      size_t j = diagonal - i;
+      // First run's element i not after second run's element j - 1: it is among the first diagonal outputs
+      if (!comparator(src[middle + j - 1], src[start + i])) {
+        low = i + 1;
+      } else {
+        high = i;
+      }
+    }
+    return low;
+  }
+
+  template <typename T, typename F>
+  inline static void merge(T* src, T* dst, size_t start1, size_t end1, size_t start2, size_t end2, size_t dest, F& comparator) {
+    while (start1 < end1 && start2 < end2) {
+      // Ties take the first run, which keeps the sort stable
+      dst[dest++] = std::move(comparator(src[start2], src[start1]) ? src[start2++] : src[start1++]);
+    }
+    while (start1 < end1) dst[dest++] = std::move(src[start1++]);
+    while (start2 < end2) dst[dest++] = std::move(src[start2++]);
+  }
+
+  // Stable sort of [begin, end) of src into dst: insertion sorted runs, then merges back and forth
+  template <typename T, typename F>
+  inline static void sortRun(T* src, T* dst, size_t begin, size_t end, F& comparator) {
+    for (size_t start = begin; start < end; start += INSERTION_RUN) {
+      size_t stop = start + INSERTION_RUN < end ? start + INSERTION_RUN : end;
+      for (size_t i = start + 1; i < stop; i++) {
+        for (size_t j = i; j > start && comparator(src[j], src[j - 1]); j--) {
+          std::swap(src[j], src[j - 1]);
+        }
+      }
+    }
+
+    T* from = src;
+    T* to = dst;
+    for (size_t width = INSERTION_RUN; width < end - begin; width *= 2) {
+      for (size_t start = begin; start < end; start += 2 * width) {
+        size_t middle = start + width < end ? start + width : end;
+        size_t stop = middle + width < end ? middle + width : end;
+        merge(from, to, start, middle, middle, stop, start, comparator);
+      }
+      std::swap(from, to);
+    }
+
+    if (from != dst) {
+      for (size_t i = begin; i < end; i++) {
+        dst[i] = std::move(from[i]);
+      }
+    }
+  }
+
+ private:
+  size_t m_threads;
+  size_t m_cutoff;
+  ThreadPool* m_pool;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_SORT_PARALLEL_MERGE_H_ */
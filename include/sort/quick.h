@@ -0,0 +1,227 @@
+#ifndef _MRT_COLLECTIONS_SORT_QUICK_H_
+#define _MRT_COLLECTIONS_SORT_QUICK_H_ 1
+
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <cstdint>
+#include <cstdlib>
+#include <bit>
+#include <mrt/sort.h>
+#include <mrt/array.h>
+
+namespace mrt {
+
+/*
+  Unstable introsort: quicksort on median-of-three pivots (ninther over NINTHER_THRESHOLD elements),
+  insertion sort under INSERTION_CUTOFF elements, and heapsort for a range once recursion gets
+  2 * log2(n) levels deep, so adversarial inputs stay O(n log n). A pivot equal to the one before the range puts every equal element to
+  the left in one pass, inputs with few distinct keys don't degrade.
+  Arithmetic elements are partitioned branchlessly in blocks: offsets of misplaced elements are
+  collected with data-dependent adds instead of jumps, then swapped in pairs.
+  Non-contiguous collections are moved into an Array and back.
+*/
+class QuickSort {
+ public:
+  template <typename C, typename F, typename T = std::remove_reference_t<decltype(std::declval<C&>()[0])>>
+  requires Collection<C, T> and Comparator<F, T>
+  inline void sort(F comparator, C& collection) {
+    size_t size = collection.size();
+    if (size < 2) return;
+
+    if constexpr (requires { { collection.data() } -> std::same_as<T*>; }) {
+      sortElements(collection.data(), size, comparator);
+    } else {
+      Array<T> elements = Array<T>::empty(size + 1);
+      for (size_t i = 0; i < size; i++) {
+        elements.append(std::move(collection[i]));
+      }
+      sortElements(elements.data(), size, comparator);
+      for (size_t i = 0; i < size; i++) {
+        collection[i] = std::move(elements[i]);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t INSERTION_CUTOFF = 24;
+  static constexpr size_t NINTHER_THRESHOLD = 128;
+  static constexpr size_t BLOCK = 64;
+
+  template <typename T, typename F>
+  inline static void sortElements(T* data, size_t size, F& comparator) {
+    introsort(data, 0, size, 2 * (size_t) std::bit_width(size), false, comparator);
+  }
+
+  // hasPivotBefore: data[begin - 1] is the pivot of an enclosing partition, not after any element of the range
+  template <typename T, typename F>
+  inline static void introsort(T* data, size_t begin, size_t end, size_t depth, bool hasPivotBefore, F& comparator) {
+    // Recurses into the smaller part and loops on the larger one, the stack stays O(log n)
+    while (end - begin > INSERTION_CUTOFF) {
+      if (!depth--) {
+        heapsort(data, begin, end, comparator);
+        return;
+      }
+
+      choosePivot(data, begin, end, comparator);
+
+      // Range is at least the previous pivot: elements equal to this pivot need no more sorting
+      if (hasPivotBefore && !comparator(data[begin - 1], data[begin])) {
+        begin = partitionEqual(data, begin, end, comparator);
+        continue;
+      }
+
+      size_t pivot = partition(data, begin, end, comparator);
+      if (pivot - begin < end - pivot) {
+        introsort(data, begin, pivot, depth, hasPivotBefore, comparator);
+        begin = pivot + 1;
+        hasPivotBefore = true;
+      } else {
+        introsort(data, pivot + 1, end, depth, true, comparator);
+        end = pivot;
+      }
+    }
+    insertionSort(data, begin, end, comparator);
+  }
+
+  // Moves the pivot to data[begin], where partition() takes it from
+  template <typename T, typename F>
+  inline static void choosePivot(T* data, size_t begin, size_t end, F& comparator) {
+    size_t middle = begin + (end - begin) / 2;
+    if (end - begin > NINTHER_THRESHOLD) {
+      // Median of the medians of three spread triples, large ranges are sampled at nine points
+      size_t step = (end - begin) / 8;
+      medianOfThree(data, begin + 1, begin + step, begin + 2 * step, comparator);
+      medianOfThree(data, middle, middle - step, middle + step, comparator);
+      medianOfThree(data, end - 1, end - 1 - step, end - 1 - 2 * step, comparator);
+      std::swap(data[begin], data[begin + 1]);
+    }
+    medianOfThree(data, begin, middle, end - 1, comparator);
+  }
+
+  // Median of data[a], data[b], data[c] goes to data[a]
+  template <typename T, typename F>
+  inline static void medianOfThree(T* data, size_t a, size_t b, size_t c, F& comparator) {
+    if (comparator(data[b], data[a])) std::swap(data[a], data[b]);
+    if (comparator(data[c], data[b])) std::swap(data[b], data[c]);
+    if (comparator(data[b], data[a])) std::swap(data[a], data[b]);
+    std::swap(data[a], data[b]);
+  }
+
+  /*
+    Partitions [begin, end) around data[begin]: elements before the returned index are ordered
+    before the pivot, elements after it are not.
+  */
+  template <typename T, typename F>
+  inline static size_t partition(T* data, size_t begin, size_t end, F& comparator) {
+    size_t left = begin + 1;
+    size_t right = end;
+
+    if constexpr (std::is_arithmetic_v<T>) {
+      T pivot = data[begin];
+      uint8_t offsetsLeft[BLOCK];
+      uint8_t offsetsRight[BLOCK];
+      size_t countLeft = 0, countRight = 0, startLeft = 0, startRight = 0;
+
+      // Elements left of left are before the pivot, elements from right on are not
+      while (right - left > 2 * BLOCK) {
+        if (!countLeft) {
+          startLeft = 0;
+          for (size_t i = 0; i < BLOCK; i++) {
+            offsetsLeft[countLeft] = (uint8_t) i;
+            countLeft += !comparator(data[left + i], pivot);
+          }
+        }
+        if (!countRight) {
+          startRight = 0;
+          for (size_t i = 0; i < BLOCK; i++) {
+            offsetsRight[countRight] = (uint8_t) i;
+            countRight += comparator(data[right - 1 - i], pivot);
+          }
+        }
+
+        size_t count = countLeft < countRight ? countLeft : countRight;
+        for (size_t i = 0; i < count; i++) {
+          std::swap(data[left + offsetsLeft[startLeft + i]], data[right - 1 - offsetsRight[startRight + i]]);
+        }
+        countLeft -= count;
+        countRight -= count;
+        startLeft += count;
+        startRight += count;
+
+        if (!countLeft) left += BLOCK;
+        if (!countRight) right -= BLOCK;
+      }
+      // A half-swapped block is still inside [left, right) and gets partitioned again below
+    }
+
+    while (true) {
+      while (left < right && comparator(data[left], data[begin])) left++;
+      while (left < right && !comparator(data[right - 1], data[begin])) right--;
+      if (left >= right) break;
+      std::swap(data[left++], data[--right]);
+    }
+
+    if (left - 1 != begin) std::swap(data[begin], data[left - 1]);
+    return left - 1;
+  }
+
+  // Moves elements not after data[begin] to the front, returns where the rest starts
+  template <typename T, typename F>
+  inline static size_t partitionEqual(T* data, size_t begin, size_t end, F& comparator) {
+    size_t left = begin + 1;
+    size_t right = end;
+
+    while (true) {
+      while (left < right && !comparator(data[begin], data[left])) left++;
+      while (left < right && comparator(data[begin], data[right - 1])) right--;
+      if (left >= right) break;
+      std::swap(data[left++], data[--right]);
+    }
+    return left;
+  }
+
+  template <typename T, typename F>
+  inline static void insertionSort(T* data, size_t begin, size_t end, F& comparator) {
+    for (size_t i = begin + 1; i < end; i++) {
+      if (!comparator(data[i], data[i - 1])) continue;
+
+      T value = std::move(data[i]);
+      size_t j = i;
+      do {
+        data[j] = std::move(data[j - 1]);
+        j--;
+      } while (j > begin && comparator(value, data[j - 1]));
+      data[j] = std::move(value);
+    }
+  }
+
+  template <typename T, typename F>
+  inline static void heapsort(T* data, size_t begin, size_t end, F& comparator) {
+    T* heap = data + begin;
+    size_t size = end - begin;
+
+    for (size_t i = size / 2; i > 0; i--) {
+      siftDown(heap, i - 1, size, comparator);
+    }
+    for (size_t last = size - 1; last > 0; last--) {
+      std::swap(heap[0], heap[last]);
+      siftDown(heap, 0, last, comparator);
+    }
+  }
+
+  template <typename T, typename F>
+  inline static void siftDown(T* heap, size_t node, size_t size, F& comparator) {
+    while (2 * node + 1 < size) {
+      size_t child = 2 * node + 1;
+      if (child + 1 < size && comparator(heap[child], heap[child + 1])) child++;
+      if (!comparator(heap[node], heap[child])) return;
+      std::swap(heap[node], heap[child]);
+      node = child;
+    }
+  }
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_SORT_QUICK_H_ */
@@ -0,0 +1,163 @@
+#ifndef _MRT_COLLECTIONS_SORT_RADIX_H_
+#define _MRT_COLLECTIONS_SORT_RADIX_H_ 1
+
+#include <type_traits>
+#include <concepts>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <bit>
+#include <mrt/sort/merge.h>
+#include <mrt/sort.h>
+#include <mrt/array.h>
+
+namespace mrt {
+
+// Integer and floating point keys of 1, 2, 4 or 8 bytes
+template <typename K>
+concept RadixKey = (std::integral<K> || std::floating_point<K>) && std::has_single_bit(sizeof(K)) && sizeof(K) <= 8;
+
+namespace radix {
+
+template <size_t Size>
+using UnsignedOf = std::conditional_t<Size == 1, uint8_t,
+  std::conditional_t<Size == 2, uint16_t, std::conditional_t<Size == 4, uint32_t, uint64_t>>>;
+
+// Unsigned value whose order matches the key's: the sign bit of signed integers is flipped,
+// negative floats have every bit flipped and positive ones only the sign bit
+template <RadixKey K>
+inline UnsignedOf<sizeof(K)> toBits(K key) {
+  using U = UnsignedOf<sizeof(K)>;
+  constexpr U SIGN = (U) 1 << (sizeof(K) * 8 - 1);
+  if constexpr (std::floating_point<K>) {
+    U bits = std::bit_cast<U>(key);
+    return bits & SIGN ? (U) ~bits : (U) (bits | SIGN);
+  } else if constexpr (std::is_signed_v<K>) {
+    return (U) key ^ SIGN;
+  } else {
+    return (U) key;
+  }
+}
+
+} /* namespace radix */
+
+/*
+  LSD radix sort, one stable counting pass per key byte. Histograms of every byte are taken
+  in a single read of the keys, and a byte that is equal in all keys skips its pass.
+  Needs n extra elements of memory. Order is only known for Ascending and Descending
+  comparators of RadixKey elements, any other comparator falls back to MergeSort.
+  sort(key, collection) orders by a RadixKey taken from every element instead.
+*/
+class RadixSort {
+ public:
+  template <typename C, typename F, typename T = std::remove_reference_t<decltype(std::declval<C&>()[0])>>
+  requires Collection<C, T> and Comparator<F, T>
+  inline void sort(F comparator, C& collection) {
+    if constexpr (RadixKey<T> && std::same_as<F, Ascending<T>>) {
+      sortBy(collection, [](const T& value) { return radix::toBits(value); });
+    } else if constexpr (RadixKey<T> && std::same_as<F, Descending<T>>) {
+      sortBy(collection, [](const T& value) { return (decltype(radix::toBits(value))) ~radix::toBits(value); });
+    } else {
+      MergeSort().sort(comparator, collection);
+    }
+  }
+
+  // Ascending by key(element), stable
+  template <typename C, typename K, typename T = std::remove_reference_t<decltype(std::declval<C&>()[0])>>
+  requires Collection<C, T> and std::invocable<K&, const T&> and RadixKey<std::invoke_result_t<K&, const T&>>
+  inline void sort(K key, C& collection) {
+    sortBy(collection, [&key](const T& value) { return radix::toBits(key(value)); });
+  }
+
+ private:
+  template <typename T, typename C, typename B>
+  inline static void sortCollection(C& collection, B bits) {
+    size_t size = collection.size();
+    if (size < 2) return;
+
+    if constexpr (std::is_trivially_copyable_v<T> && requires { { collection.data() } -> std::same_as<T*>; }) {
+      sortElements(collection.data(), size, bits);
+    } else {
+      // Sorts (key, index) entries, then permutes in place: one move per element, plus one per cycle
+      using U = decltype(bits(collection[0]));
+      struct Entry {
+        U key;
+        size_t index;
+      };
+
+      Array<Entry> entries = Array<Entry>::empty(size + 1);
+      for (size_t i = 0; i < size; i++) {
+        entries.append(Entry{bits(collection[i]), i});
+      }
+      sortElements(entries.data(), size, [](const Entry& entry) { return entry.key; });
+
+      // Follows each cycle of the permutation, a placed element's entry points at itself
+      for (size_t i = 0; i < size; i++) {
+        if (entries[i].index == i) continue;
+
+        T value = std::move(collection[i]);
+        size_t j = i;
+        while (entries[j].index != i) {
+          size_t from = entries[j].index;
+          collection[j] = std::move(collection[from]);
+          entries[j].index = j;
+          j = from;
+        }
+        collection[j] = std::move(value);
+        entries[j].index = j;
+      }
+    }
+  }
+
+  template <typename C, typename B>
+  inline static void sortBy(C& collection, B bits) {
+    sortCollection<std::remove_reference_t<decltype(collection[0])>>(collection, bits);
+  }
+
+  template <typename E, typename B>
+  inline static void sortElements(E* data, size_t size, B bits) {
+    using U = decltype(bits(*data));
+    constexpr size_t BYTES = sizeof(U);
+
+    size_t counts[BYTES][256] = {};
+    for (size_t i = 0; i < size; i++) {
+      U key = bits(data[i]);
+      for (size_t b = 0; b < BYTES; b++) {
+        counts[b][(key >> (b * 8)) & 0xFF]++;
+      }
+    }
+
+    Array<E> buffer = Array<E>::empty(size + 1);
+    E* src = data;
+    E* dst = buffer.appendUninitialized(size);
+
+    for (size_t b = 0; b < BYTES; b++) {
+      size_t offsets[256];
+      size_t total = 0;
+      bool skip = false;
+      for (size_t i = 0; i < 256; i++) {
+        if (counts[b][i] == size) {
+          skip = true;
+          break;
+        }
+        offsets[i] = total;
+        total += counts[b][i];
+      }
+      if (skip) continue;
+
+      for (size_t i = 0; i < size; i++) {
+        dst[offsets[(bits(src[i]) >> (b * 8)) & 0xFF]++] = src[i];
+      }
+      std::swap(src, dst);
+    }
+
+    if (src != data) {
+      std::memcpy(data, src, size * sizeof(E));
+    }
+  }
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_SORT_RADIX_H_ */
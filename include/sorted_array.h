@@ -0,0 +1,243 @@
+#ifndef _MRT_COLLECTIONS_SORTED_ARRAY_H_
+#define _MRT_COLLECTIONS_SORTED_ARRAY_H_ 1
+
+#include <initializer_list>
+#include <utility>
+#include <cstdlib>
+#include <mrt/utils/constants.h>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
+#include <mrt/array_view.h>
+#include <mrt/array.h>
+#include <mrt/pair.h>
+#include <mrt/sort/quick.h>
+#include <mrt/sort.h>
+
+namespace mrt {
+
+/*
+  Array kept ordered by F, equal elements are allowed and keep insertion order.
+  Lookups are binary searches without data-dependent branches: the search range is halved
+  with a conditional move, so lookups of random keys don't pay for mispredictions.
+  insertMany() sorts the batch and merges it with the elements in one pass.
+*/
+template <typename T, typename F = Ascending<T>, Allocator A = DefaultAllocator>
+requires Predicate<F, const T&, const T&>
+class SortedArray {
+ public:
+  inline SortedArray(F comparator = {}, const A& allocator = A())
+    : m_elements(allocator), m_comparator(comparator) {}
+
+  inline SortedArray(std::initializer_list<T> il, F comparator = {}, const A& allocator = A())
+    : m_elements(allocator), m_comparator(comparator) {
+    insertMany(ArrayView<T>(il.begin(), il.size()));
+  }
+
+  inline explicit SortedArray(ArrayView<T> values, F comparator = {}, const A& allocator = A())
+    : m_elements(allocator), m_comparator(comparator) {
+    insertMany(values);
+  }
+
+  SortedArray(const SortedArray&) = default;
+  SortedArray(SortedArray&&) = default;
+
+  SortedArray& operator=(const SortedArray&) = default;
+  SortedArray& operator=(SortedArray&&) = default;
+
+  inline virtual ~SortedArray() {}
+
+  inline size_t size() const { return m_elements.size(); }
+  inline bool isEmpty() const { return m_elements.size() == 0; }
+  inline const A& allocator() const { return m_elements.allocator(); }
+
+  inline const T* data() const { return m_elements.data(); }
+
+  inline const T* begin() const { return m_elements.data(); }
+  inline const T* end() const { return m_elements.data() + m_elements.size(); }
+
+  inline ArrayView<T> view(size_t start = 0, size_t end = nidx) const {
+    return m_elements.view(start, end);
+  }
+
+  // Index of the first element not ordered before value
+  inline size_t lowerBound(const T& value) const {
+    return bound(value, [this](const T& element, const T& value) { return m_comparator(element, value); });
+  }
+
+  // Index of the first element ordered after value
+  inline size_t upperBound(const T& value) const {
+    return bound(value, [this](const T& element, const T& value) { return !m_comparator(value, element); });
+  }
+
+  // Elements equal to value are [_1, _2)
+  inline Pair<size_t, size_t> equalRange(const T& value) const {
+    return Pair<size_t, size_t>(lowerBound(value), upperBound(value));
+  }
+
+  // Index of the first element equal to value, or nidx
+  inline size_t binarySearch(const T& value) const {
+    size_t index = lowerBound(value);
+    return index < size() && !m_comparator(value, m_elements[index]) ? index : nidx;
+  }
+
+  inline bool contains(const T& value) const {
+    return binarySearch(value) != nidx;
+  }
+
+  inline size_t count(const T& value) const {
+    auto [lower, upper] = equalRange(value);
+    return upper - lower;
+  }
+
+  // Returns the index value was inserted at, after any equal elements
+  inline size_t insert(const T& value) {
+    size_t index = upperBound(value);
+    m_elements.insert(index, value);
+    return index;
+  }
+
+  inline size_t insert(T&& value) {
+    size_t index = upperBound(value);
+    m_elements.insert(index, std::move(value));
+    return index;
+  }
+
+  /*
+    Sorts a copy of values and merges it with the elements in one pass, O(n + k log k) instead of
+    k shifting inserts. A batch that goes entirely after the last element is appended in place.
+    Equal values keep their order in values, like k insert() calls would.
+  */
+  inline void insertMany(ArrayView<T> values) {
+    if (!values.size()) return;
+
+    // Indices break ties, so the unstable sort gives the stable order
+    Array<size_t> order = Array<size_t>::empty(values.size() + 1);
+    for (size_t i = 0; i < values.size(); i++) {
+      order.append(i);
+    }
+    order.sort([this, &values](size_t& lhs, size_t& rhs) {
+      return m_comparator(values[lhs], values[rhs]) || (!m_comparator(values[rhs], values[lhs]) && lhs < rhs);
+    }, QuickSort());
+
+    Array<T, A> batch = Array<T, A>::empty(values.size() + 1, allocator());
+    for (size_t i = 0; i < order.size(); i++) {
+      batch.append(values[order[i]]);
+    }
+
+    if (isEmpty() || !m_comparator(batch[0], m_elements[size() - 1])) {
+      m_elements += batch.view();
+      return;
+    }
+
+    Array<T, A> result = Array<T, A>::empty(size() + batch.size() + 1, allocator());
+    size_t i = 0, j = 0;
+    while (i < size() && j < batch.size()) {
+      // Existing elements go first among equal ones
+      if (m_comparator(batch[j], m_elements[i])) {
+        result.append(std::move(batch[j++]));
+      } else {
+        result.append(std::move(m_elements[i++]));
+      }
+    }
+    while (i < size()) result.append(std::move(m_elements[i++]));
+    while (j < batch.size()) result.append(std::move(batch[j++]));
+
+    m_elements = std::move(result);
+  }
+
+  inline void remove(size_t index) {
+    m_elements.remove(index);
+  }
+
+  // Removes every element equal to value, returns how many there were
+  inline size_t removeAll(const T& value) {
+    auto [lower, upper] = equalRange(value);
+    if (lower < upper) m_elements.remove(lower, upper);
+    return upper - lower;
+  }
+
+  inline void reserve(size_t size) {
+    m_elements.reserve(size + 1);
+  }
+
+  inline void clear() {
+    m_elements.clear();
+  }
+
+  inline const T& operator[](size_t index) const {
+    return m_elements[index];
+  }
+
+  inline const T& first() const {
+    return m_elements[0];
+  }
+
+  inline const T& last() const {
+    return m_elements[size() - 1];
+  }
+
+  template <Consumer<const T&> C>
+  inline void foreach(C f) const {
+    m_elements.foreach(f);
+  }
+
+  // Filtering keeps the order, so the result is sorted too
+  template <Predicate<const T&> P>
+  inline SortedArray filter(P pred) const {
+    SortedArray result(m_comparator, allocator());
+    m_elements.foreach([&result, &pred](const T& value) {
+      if (pred(value)) result.m_elements.append(value);
+    });
+    return result;
+  }
+
+  template <typename R = T, Callable<R, R, const T&> C>
+  inline R reduce(C reducer, R startValue = {}) const {
+    return m_elements.template reduce<R>(reducer, startValue);
+  }
+
+  inline const Array<T, A>& toArray() const {
+    return m_elements;
+  }
+
+  inline size_t memoryUsage() const {
+    return m_elements.memoryUsage();
+  }
+
+  inline MemoryStats stats() const {
+    return m_elements.stats();
+  }
+
+  inline bool operator==(const SortedArray& rhs) const {
+    return m_elements == rhs.m_elements;
+  }
+
+  inline bool operator!=(const SortedArray& rhs) const {
+    return !operator==(rhs);
+  }
+
+ private:
+  // First index for which before(element, value) is false, elements have to be partitioned by it
+  template <typename B>
+  inline size_t bound(const T& value, B before) const {
+    const T* base = m_elements.data();
+    size_t length = size();
+    if (!length) return 0;
+
+    while (length > 1) {
+      size_t half = length / 2;
+      base = before(base[half], value) ? base + half : base;
+      length -= half;
+    }
+    return (base - m_elements.data()) + before(*base, value);
+  }
+
+ private:
+  Array<T, A> m_elements;
+  [[no_unique_address]] F m_comparator;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_SORTED_ARRAY_H_ */
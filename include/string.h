@@ -91,9 +91,9 @@ class BaseString : public Array<T> {
   }
 
   inline BaseString(const T* s, size_t length) : Array<T>() {
-    for (size_t i = 0; i < length; i++) {
-      append(s[i]);
-    }
+    this->reserve(length + 1);
+    this->Array<T>::operator+=(ArrayView<T>(s, length));
+    addNull();
   }
 
   inline BaseString(const std::string& s) : Array<T>() {
@@ -233,17 +233,21 @@ class BaseString : public Array<T> {
     return this->Array<T>::lfind(c, startIdx);
   }
 
-  inline size_t find(const BaseString& pattern, size_t startIdx = 0) const {
-    size_t patternHash = pattern.hash();
-    for (size_t i = startIdx; i < this->size(); i++) {
-      auto sub = this->substr(i, i + pattern.size());
-      if (sub.hash() == patternHash && sub == pattern) {
+  // Candidates are found by searching for the first character, then compared in place without copying
+  inline size_t find(ArrayView<T> pattern, size_t startIdx = 0) const {
+    if (!pattern.size()) return startIdx < this->size() ? startIdx : nidx;
+    for (size_t i = this->lfind(pattern[0], startIdx); i != nidx && i + pattern.size() <= this->size(); i = this->lfind(pattern[0], i + 1)) {
+      if (this->view(i, i + pattern.size()) == pattern) {
         return i;
       }
     }
     return nidx;
   }
 
+  inline size_t find(const BaseString& pattern, size_t startIdx = 0) const {
+    return find(pattern.view(), startIdx);
+  }
+
   template <typename... Args>
   inline BaseString format(Args&&... args) const {
     return BaseString::format(c_str(), args...);
@@ -488,6 +492,9 @@ inline BaseString<CharT> toString(const List<T>& value) {
 
 using String = BaseString<char>;
 
+// String whose copies share characters until one of them is mutated, see Cow
+using CowString = Cow<String>;
+
 } /* namespace mrt */
 
 #endif /* _MRT_COLLECTIONS_STRING_H_ */
@@ -0,0 +1,155 @@
+#ifndef _MRT_COLLECTIONS_THREAD_POOL_H_
+#define _MRT_COLLECTIONS_THREAD_POOL_H_ 1
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <cstdlib>
+
+namespace mrt {
+
+/*
+  Fixed set of worker threads fed from one task queue.
+  The thread calling parallelFor() works on chunks too, so a pool of N threads has N - 1 workers,
+  and a parallelFor() issued from inside a task still finishes when every worker is busy.
+*/
+class ThreadPool {
+ public:
+  inline ThreadPool(size_t threads = defaultThreads()) : m_threads(threads ? threads : 1) {
+    for (size_t i = 1; i < m_threads; i++) {
+      m_workers.emplace_back([this]() { work(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Queued tasks are still run before workers exit
+  inline ~ThreadPool() {
+    {
+      std::lock_guard lock(m_mutex);
+      m_stop = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  // Shared pool with one thread per hardware thread, created on first use
+  inline static ThreadPool& global() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  inline static size_t defaultThreads() {
+    size_t threads = std::thread::hardware_concurrency();
+    return threads ? threads : 1;
+  }
+
+  inline size_t threads() const {
+    return m_threads;
+  }
+
+  inline void submit(std::function<void()> task) {
+    {
+      std::lock_guard lock(m_mutex);
+      m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+  }
+
+  /*
+    Calls body(begin, end) for every chunk [i * chunkSize, min((i + 1) * chunkSize, count)) and
+    returns once all chunks are done. First exception thrown by body is rethrown here.
+  */
+  inline void parallelFor(size_t count, size_t chunkSize, std::function<void(size_t, size_t)> body) {
+    if (!count) return;
+    if (!chunkSize) chunkSize = 1;
+
+    auto batch = std::make_shared<Batch>();
+    batch->body = &body;
+    batch->count = count;
+    batch->chunkSize = chunkSize;
+    batch->chunks = (count + chunkSize - 1) / chunkSize;
+
+    size_t helpers = batch->chunks - 1 < m_workers.size() ? batch->chunks - 1 : m_workers.size();
+    for (size_t i = 0; i < helpers; i++) {
+      submit([batch]() { batch->run(); });
+    }
+    batch->run();
+
+    {
+      std::unique_lock lock(batch->mutex);
+      batch->finished.wait(lock, [&batch]() { return batch->done == batch->chunks; });
+    }
+
+    if (batch->error) std::rethrow_exception(batch->error);
+  }
+
+ private:
+  /*
+    Shared with helper tasks, which can start after parallelFor() returned.
+    body is only touched for a claimed chunk, and parallelFor() waits for every claimed chunk.
+  */
+  struct Batch {
+    std::function<void(size_t, size_t)>* body = nullptr;
+    size_t count = 0;
+    size_t chunkSize = 0;
+    size_t chunks = 0;
+    std::atomic<size_t> next = 0;
+    std::atomic<size_t> done = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    inline void run() {
+      for (size_t i = next++; i < chunks; i = next++) {
+        size_t begin = i * chunkSize;
+        size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+        try {
+          (*body)(begin, end);
+        } catch (...) {
+          std::lock_guard lock(mutex);
+          if (!error) error = std::current_exception();
+        }
+        if (++done == chunks) {
+          std::lock_guard lock(mutex);
+          finished.notify_all();
+        }
+      }
+    }
+  };
+
+  inline void work() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+        if (m_tasks.empty()) return;
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+ private:
+  size_t m_threads;
+  std::vector<std::thread> m_workers;
+  std::deque<std::function<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_stop = false;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_THREAD_POOL_H_ */
@@ -41,6 +41,11 @@ concept Subscriptable = requires (C c, K k) {
 template <typename C, typename T>
 concept Indexable = Subscriptable<C, size_t, T>;
 
+template <typename T>
+concept Ordered = requires (const T& t1, const T& t2) {
+  { t1 < t2 } -> std::convertible_to<bool>;
+};
+
 template <typename T>
 concept Hashable = requires (T t) {
   { t.hash() } -> std::same_as<std::size_t>;
@@ -49,6 +54,16 @@ concept Hashable = requires (T t) {
 template <typename T>
 concept IsEnum = std::is_enum_v<T>;
 
+// Callables are taken by template parameter constrained on these, so lambdas can be inlined
+template <typename F, typename... Args>
+concept Consumer = std::invocable<F&, Args...>;
+
+template <typename F, typename... Args>
+concept Predicate = std::predicate<F&, Args...>;
+
+template <typename F, typename R, typename... Args>
+concept Callable = std::invocable<F&, Args...> and std::convertible_to<std::invoke_result_t<F&, Args...>, R>;
+
 template <typename T>
 concept ConvertibleToString = requires (T t) {
   t.toString();
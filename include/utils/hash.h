@@ -0,0 +1,91 @@
+#ifndef _MRT_COLLECTIONS_UTILS_HASH_H_
+#define _MRT_COLLECTIONS_UTILS_HASH_H_ 1
+
+#include <type_traits>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <mrt/utils/concepts.h>
+
+namespace mrt {
+
+template <typename T>
+inline size_t getHash(const T& value) {
+  return std::hash<T>{}(value);
+}
+
+template <Hashable T>
+inline size_t getHash(const T& value) {
+  return value.hash();
+}
+
+template <IsEnum T>
+inline size_t getHash(const T& value) {
+  return (size_t) value;
+}
+
+template <>
+inline size_t getHash(const int& value) {
+  return value;
+}
+
+template <>
+inline size_t getHash(const long& value) {
+  return value;
+}
+
+template <>
+inline size_t getHash(const long long& value) {
+  return value;
+}
+
+template <>
+inline size_t getHash(const unsigned& value) {
+  return value;
+}
+
+template <>
+inline size_t getHash(const unsigned long& value) {
+  return value;
+}
+
+template <>
+inline size_t getHash(const unsigned long long& value) {
+  return value;
+}
+
+// -0.0 == 0.0, so both have to hash the same
+template <>
+inline size_t getHash(const float& value) {
+  uint32_t bits = 0;
+  if (value != 0) std::memcpy(&bits, &value, sizeof(value));
+  return bits;
+}
+
+template <>
+inline size_t getHash(const double& value) {
+  uint64_t bits = 0;
+  if (value != 0) std::memcpy(&bits, &value, sizeof(value));
+  return bits;
+}
+
+inline size_t getHash(const void* value) {
+  return (size_t) value;
+}
+
+// Types getHash() compiles for, the generic overload needs an enabled std::hash specialization
+template <typename T>
+concept HashKey = Hashable<T> or IsEnum<T> or std::is_default_constructible_v<std::hash<T>>;
+
+// Spreads entropy of weak hashes (e.g. identity hash of integers) over all bits
+inline size_t mixHash(size_t hash) {
+  hash ^= hash >> 32;
+  hash *= 0x9E3779B97F4A7C15ULL;
+  hash ^= hash >> 29;
+  return hash;
+}
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_UTILS_HASH_H_ */
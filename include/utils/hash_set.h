@@ -0,0 +1,117 @@
+#ifndef _MRT_COLLECTIONS_UTILS_HASH_SET_H_
+#define _MRT_COLLECTIONS_UTILS_HASH_SET_H_ 1
+
+#include <type_traits>
+#include <utility>
+#include <cstdlib>
+#include <new>
+#include <mrt/utils/hash.h>
+#include <mrt/allocator.h>
+
+namespace mrt {
+
+/*
+  Insert-only open addressing set with linear probing, used by unique() and set operations of collections.
+  Full hash of every element is kept next to it, so probing mostly compares integers and growing never rehashes.
+*/
+template <HashKey T, Allocator A = DefaultAllocator>
+class HashSet {
+ public:
+  constexpr static size_t INITIAL_CAPACITY = 16;
+
+ public:
+  inline HashSet(size_t expected = 0, const A& allocator = A()) : m_allocator(allocator) {
+    reserve(expected);
+  }
+
+  HashSet(const HashSet&) = delete;
+  HashSet& operator=(const HashSet&) = delete;
+
+  inline ~HashSet() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = 0; i < m_capacity; i++) {
+        if (m_hashes[i]) m_slots[i].~T();
+      }
+    }
+    deallocate(m_slots, m_hashes, m_capacity);
+  }
+
+  inline size_t size() const { return m_size; }
+  inline size_t capacity() const { return m_capacity; }
+
+  // Makes room for count elements without growing, load factor is kept at or below 1/2
+  inline void reserve(size_t count) {
+    size_t capacity = INITIAL_CAPACITY;
+    while (capacity < count * 2) capacity *= 2;
+    if (capacity > m_capacity) rehash(capacity);
+  }
+
+  // Returns false if an equal element was already present
+  inline bool insert(const T& value) {
+    if ((m_size + 1) * 2 > m_capacity) rehash(m_capacity * 2);
+    size_t hash = hashOf(value);
+    size_t i = find(value, hash);
+    if (m_hashes[i]) return false;
+    new (m_slots + i) T(value);
+    m_hashes[i] = hash;
+    m_size++;
+    return true;
+  }
+
+  inline bool contains(const T& value) const {
+    return m_hashes[find(value, hashOf(value))] != 0;
+  }
+
+ private:
+  // 0 marks an empty slot, so stored hashes always have the lowest bit set
+  inline static size_t hashOf(const T& value) {
+    return mixHash(getHash(value)) | 1;
+  }
+
+  // Slot holding value, or the empty slot where it would be inserted
+  inline size_t find(const T& value, size_t hash) const {
+    size_t mask = m_capacity - 1;
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+      if (!m_hashes[i] || (m_hashes[i] == hash && m_slots[i] == value)) return i;
+    }
+  }
+
+  inline void rehash(size_t capacity) {
+    T* slots = static_cast<T*>(m_allocator.allocate(capacity * sizeof(T), alignof(T)));
+    size_t* hashes = static_cast<size_t*>(m_allocator.allocate(capacity * sizeof(size_t), alignof(size_t)));
+    for (size_t i = 0; i < capacity; i++) {
+      hashes[i] = 0;
+    }
+
+    for (size_t i = 0; i < m_capacity; i++) {
+      if (!m_hashes[i]) continue;
+      size_t j = m_hashes[i] & (capacity - 1);
+      while (hashes[j]) j = (j + 1) & (capacity - 1);
+      new (slots + j) T(std::move(m_slots[i]));
+      m_slots[i].~T();
+      hashes[j] = m_hashes[i];
+    }
+
+    deallocate(m_slots, m_hashes, m_capacity);
+    m_slots = slots;
+    m_hashes = hashes;
+    m_capacity = capacity;
+  }
+
+  inline void deallocate(T* slots, size_t* hashes, size_t capacity) {
+    if (!capacity) return;
+    m_allocator.deallocate(slots, capacity * sizeof(T), alignof(T));
+    m_allocator.deallocate(hashes, capacity * sizeof(size_t), alignof(size_t));
+  }
+
+ private:
+  T* m_slots = nullptr;
+  size_t* m_hashes = nullptr;
+  size_t m_capacity = 0;
+  size_t m_size = 0;
+  [[no_unique_address]] A m_allocator;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_UTILS_HASH_SET_H_ */
@@ -0,0 +1,90 @@
+#ifndef _MRT_COLLECTIONS_UTILS_MAPPED_FILE_H_
+#define _MRT_COLLECTIONS_UTILS_MAPPED_FILE_H_ 1
+
+#include <type_traits>
+#include <exception>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+
+namespace mrt {
+
+template <typename T>
+concept Mappable = std::is_trivially_copyable_v<T>;
+
+struct MappedFileException : public std::exception {
+  inline MappedFileException(const char* reason) : m_reason(reason) {}
+
+  inline const char* what() const noexcept override {
+    return m_reason;
+  }
+
+ private:
+  const char* m_reason;
+};
+
+/*
+  On-disk layout shared by Array::save() and MappedArray: a header padded to DATA_OFFSET bytes,
+  followed by the raw elements. Elements are stored in host byte order, element size and alignment
+  are recorded so a file can't be mapped as a type of a different layout.
+*/
+namespace mapped {
+
+constexpr char MAGIC[8] = {'M', 'R', 'T', 'A', 'R', 'R', 'A', 'Y'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t DATA_OFFSET = 64;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t elementSize;
+  uint32_t elementAlign;
+  uint32_t reserved;
+  uint64_t count;
+};
+
+static_assert(sizeof(Header) <= DATA_OFFSET);
+
+template <Mappable T>
+inline bool isValid(const Header& header, size_t fileSize) {
+  return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+    && header.version == VERSION
+    && header.elementSize == sizeof(T)
+    && header.elementAlign == alignof(T)
+    && header.count <= (fileSize - DATA_OFFSET) / sizeof(T);
+}
+
+/*
+  Written to path + ".tmp" and renamed over path, so processes that still map
+  the previous version keep a consistent file.
+*/
+template <Mappable T>
+inline void save(const char* path, const T* data, size_t count) {
+  static_assert(alignof(T) <= DATA_OFFSET, "Element alignment exceeds mapped data offset");
+
+  std::string tmpPath = std::string(path) + ".tmp";
+  FILE* file = std::fopen(tmpPath.c_str(), "wb");
+  if (!file) throw MappedFileException("Can't open file for writing");
+
+  char header[DATA_OFFSET] = {};
+  Header fields = {{}, VERSION, sizeof(T), alignof(T), 0, count};
+  std::memcpy(fields.magic, MAGIC, sizeof(MAGIC));
+  std::memcpy(header, &fields, sizeof(fields));
+
+  bool ok = std::fwrite(header, 1, DATA_OFFSET, file) == DATA_OFFSET
+    && (!count || std::fwrite(data, sizeof(T), count, file) == count);
+  ok = std::fclose(file) == 0 && ok;
+
+  if (!ok || std::rename(tmpPath.c_str(), path) != 0) {
+    std::remove(tmpPath.c_str());
+    throw MappedFileException("Can't write file");
+  }
+}
+
+} /* namespace mapped */
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_UTILS_MAPPED_FILE_H_ */
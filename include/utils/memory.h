@@ -0,0 +1,76 @@
+#ifndef _MRT_COLLECTIONS_UTILS_MEMORY_H_
+#define _MRT_COLLECTIONS_UTILS_MEMORY_H_ 1
+
+#include <concepts>
+#include <cstdlib>
+
+namespace mrt {
+
+/*
+  Decides the next capacity of a growing buffer: grow(capacity, required) returns at least required.
+  Larger steps mean fewer reallocations and more unused capacity.
+*/
+template <typename G>
+concept GrowthPolicy = requires (size_t capacity, size_t required) {
+  { G::grow(capacity, required) } -> std::same_as<size_t>;
+};
+
+// Capacity is multiplied by Numerator / Denominator
+template <size_t Numerator, size_t Denominator = 1>
+struct GeometricGrowth {
+  static_assert(Numerator > Denominator, "GeometricGrowth factor has to be greater than 1");
+
+  inline static size_t grow(size_t capacity, size_t required) {
+    size_t next = capacity * Numerator / Denominator;
+    if (next <= capacity) next = capacity + 1;
+    return next > required ? next : required;
+  }
+};
+
+using DoublingGrowth = GeometricGrowth<2>;
+
+// Capacity grows by Step elements, reallocations become O(n) apart but appends O(n / Step) amortized
+template <size_t Step>
+struct LinearGrowth {
+  static_assert(Step > 0, "LinearGrowth step has to be positive");
+
+  inline static size_t grow(size_t capacity, size_t required) {
+    size_t next = capacity + Step;
+    return next > required ? next : required;
+  }
+};
+
+/*
+  Shallow memory usage of a container: memory owned by the elements themselves
+  (e.g. a string's characters) is not followed.
+*/
+struct MemoryStats {
+  // Bytes currently held from the allocator
+  size_t allocated = 0;
+  // Bytes taken by live elements, size() * sizeof(element)
+  size_t live = 0;
+  // Separately allocated nodes (List, Map)
+  size_t nodes = 0;
+  // Buffers replaced by a larger one, counted since construction
+  size_t reallocations = 0;
+  // Full or incremental rehashes of hash maps, counted since construction
+  size_t rehashes = 0;
+
+  // Allocated bytes not taken by elements: spare capacity, buckets, node links, control bytes
+  inline size_t slack() const {
+    return allocated > live ? allocated - live : 0;
+  }
+
+  inline MemoryStats& operator+=(const MemoryStats& rhs) {
+    allocated += rhs.allocated;
+    live += rhs.live;
+    nodes += rhs.nodes;
+    reallocations += rhs.reallocations;
+    rehashes += rhs.rehashes;
+    return *this;
+  }
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_UTILS_MEMORY_H_ */
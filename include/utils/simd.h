@@ -0,0 +1,208 @@
+#ifndef _MRT_COLLECTIONS_UTILS_SIMD_H_
+#define _MRT_COLLECTIONS_UTILS_SIMD_H_ 1
+
+#include <type_traits>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <mrt/utils/constants.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace mrt {
+
+template <typename T>
+concept SimdSearchable = std::is_arithmetic_v<T> and !std::is_same_v<T, bool>
+  and (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8);
+
+/*
+  Equality search kernels over arithmetic arrays.
+  Width is picked at compile time: AVX2 if enabled (e.g. -mavx2 or -march=native), otherwise SSE2,
+  and plain loops on targets with neither. Floating point values are compared with ==, not bitwise.
+*/
+namespace simd {
+
+#if defined(__AVX2__) || defined(__SSE2__)
+
+#if defined(__AVX2__)
+using Register = __m256i;
+
+inline Register load(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+inline Register bitOr(Register a, Register b) { return _mm256_or_si256(a, b); }
+inline uint32_t byteMask(Register r) { return _mm256_movemask_epi8(r); }
+
+template <typename T>
+inline Register equal(Register a, Register b) {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm256_cmpeq_epi8(a, b);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm256_cmpeq_epi16(a, b);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm256_cmpeq_epi32(a, b);
+  } else {
+    return _mm256_cmpeq_epi64(a, b);
+  }
+}
+
+template <typename T>
+inline Register broadcast(T value) {
+  if constexpr (sizeof(T) == 1) {
+    int8_t bits; std::memcpy(&bits, &value, sizeof(T));
+    return _mm256_set1_epi8(bits);
+  } else if constexpr (sizeof(T) == 2) {
+    int16_t bits; std::memcpy(&bits, &value, sizeof(T));
+    return _mm256_set1_epi16(bits);
+  } else if constexpr (sizeof(T) == 4) {
+    int32_t bits; std::memcpy(&bits, &value, sizeof(T));
+    return _mm256_set1_epi32(bits);
+  } else {
+    int64_t bits; std::memcpy(&bits, &value, sizeof(T));
+    return _mm256_set1_epi64x(bits);
+  }
+}
+#else
+using Register = __m128i;
+
+inline Register load(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+inline Register bitOr(Register a, Register b) { return _mm_or_si128(a, b); }
+inline uint32_t byteMask(Register r) { return _mm_movemask_epi8(r); }
+
+template <typename T>
+inline Register equal(Register a, Register b) {
+  if constexpr (std::is_same_v<T, float>) {
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+  } else if constexpr (std::is_same_v<T, double>) {
+    return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+  } else if constexpr (sizeof(T) == 1) {
+    return _mm_cmpeq_epi8(a, b);
+  } else if constexpr (sizeof(T) == 2) {
+    return _mm_cmpeq_epi16(a, b);
+  } else if constexpr (sizeof(T) == 4) {
+    return _mm_cmpeq_epi32(a, b);
+  } else {
+    // SSE2 has no 64-bit compare, both 32-bit halves have to match
+    Register eq = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+  }
+}
+
+template <typename T>
+inline Register broadcast(T value) {
+  if constexpr (sizeof(T) == 1) {
+    int8_t bits; std::memcpy(&bits, &value, sizeof(T));
+    return _mm_set1_epi8(bits);
+  } else if constexpr (sizeof(T) == 2) {
+    int16_t bits; std::memcpy(&bits, &value, sizeof(T));
+    return _mm_set1_epi16(bits);
+  } else if constexpr (sizeof(T) == 4) {
+    int32_t bits; std::memcpy(&bits, &value, sizeof(T));
+    return _mm_set1_epi32(bits);
+  } else {
+    int64_t bits; std::memcpy(&bits, &value, sizeof(T));
+    return _mm_set1_epi64x(bits);
+  }
+}
+#endif
+
+constexpr size_t REGISTER_SIZE = sizeof(Register);
+
+// Elements per register, and how many registers are checked per iteration before locating a match
+template <typename T>
+constexpr size_t LANES = REGISTER_SIZE / sizeof(T);
+constexpr size_t UNROLL = 4;
+
+// movemask gives one bit per byte, only the lowest bit of every element is kept
+template <typename T>
+constexpr uint32_t ELEMENT_BITS = sizeof(T) == 1 ? 0xFFFFFFFF : sizeof(T) == 2 ? 0x55555555 : sizeof(T) == 4 ? 0x11111111 : 0x01010101;
+
+template <typename T>
+inline uint32_t match(const T* data, Register needle) {
+  return byteMask(equal<T>(load(data), needle)) & ELEMENT_BITS<T>;
+}
+
+#endif
+
+// Index of the first element equal to value, or nidx
+template <SimdSearchable T>
+inline size_t find(const T* data, size_t size, T value) {
+  size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+  Register needle = broadcast(value);
+  for (; i + UNROLL * LANES<T> <= size; i += UNROLL * LANES<T>) {
+    Register eq = bitOr(
+      bitOr(equal<T>(load(data + i), needle), equal<T>(load(data + i + LANES<T>), needle)),
+      bitOr(equal<T>(load(data + i + 2 * LANES<T>), needle), equal<T>(load(data + i + 3 * LANES<T>), needle))
+    );
+    if (byteMask(eq)) break;
+  }
+  for (; i + LANES<T> <= size; i += LANES<T>) {
+    uint32_t mask = match(data + i, needle);
+    if (mask) return i + __builtin_ctz(mask) / sizeof(T);
+  }
+#endif
+  for (; i < size; i++) {
+    if (data[i] == value) return i;
+  }
+  return nidx;
+}
+
+// Index of the last element equal to value, or nidx
+template <SimdSearchable T>
+inline size_t rfind(const T* data, size_t size, T value) {
+  size_t i = size;
+#if defined(__AVX2__) || defined(__SSE2__)
+  Register needle = broadcast(value);
+  while (i >= LANES<T>) {
+    i -= LANES<T>;
+    uint32_t mask = match(data + i, needle);
+    if (mask) return i + (31 - __builtin_clz(mask)) / sizeof(T);
+  }
+#endif
+  while (i > 0) {
+    if (data[--i] == value) return i;
+  }
+  return nidx;
+}
+
+// Calls out(index) for every element equal to value, in order
+template <SimdSearchable T, typename F>
+inline void findAll(const T* data, size_t size, T value, F out) {
+  size_t i = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+  Register needle = broadcast(value);
+  for (; i + LANES<T> <= size; i += LANES<T>) {
+    // Matches are usually sparse, so blocks without any are skipped with a single test
+    if (i % (UNROLL * LANES<T>) == 0 && i + UNROLL * LANES<T> <= size) {
+      Register eq = bitOr(
+        bitOr(equal<T>(load(data + i), needle), equal<T>(load(data + i + LANES<T>), needle)),
+        bitOr(equal<T>(load(data + i + 2 * LANES<T>), needle), equal<T>(load(data + i + 3 * LANES<T>), needle))
+      );
+      if (!byteMask(eq)) {
+        i += (UNROLL - 1) * LANES<T>;
+        continue;
+      }
+    }
+    for (uint32_t mask = match(data + i, needle); mask; mask &= mask - 1) {
+      out(i + __builtin_ctz(mask) / sizeof(T));
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    if (data[i] == value) out(i);
+  }
+}
+
+} /* namespace simd */
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_UTILS_SIMD_H_ */
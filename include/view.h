@@ -0,0 +1,110 @@
+#ifndef _MRT_COLLECTIONS_VIEW_H_
+#define _MRT_COLLECTIONS_VIEW_H_ 1
+
+#include <type_traits>
+#include <functional>
+#include <concepts>
+#include <utility>
+#include <cstdlib>
+#include <mrt/utils/concepts.h>
+#include <mrt/utils/memory.h>
+#include <mrt/allocator.h>
+
+namespace mrt {
+
+template <typename T, Allocator A, GrowthPolicy G>
+class Array;
+
+template <typename T, typename S>
+class View;
+
+template <typename T, typename S>
+inline View<T, S> makeView(S source) {
+  return View<T, S>(std::move(source));
+}
+
+/*
+  Lazy pipeline over a collection, e.g. arr.view().filter(p).map(f).take(n).reduce(r).
+  Stages are fused into one pass and nothing is stored until collect().
+  Source is a callable taking a sink, it passes every element to sink and stops once sink returns false.
+  Views don't own the elements, so the collection has to outlive the view.
+*/
+template <typename T, typename S>
+class View {
+ public:
+  using Type = T;
+
+ public:
+  inline View(S source) : m_source(std::move(source)) {}
+
+  template <Predicate<const T&> F>
+  inline auto filter(F pred) const {
+    return makeView<T>([source = m_source, pred](auto&& sink) mutable {
+      source([&](const T& value) { return !pred(value) || sink(value); });
+    });
+  }
+
+  template <Consumer<const T&> F, typename R = std::decay_t<std::invoke_result_t<F&, const T&>>>
+  inline auto map(F mapper) const {
+    return makeView<R>([source = m_source, mapper](auto&& sink) mutable {
+      source([&](const T& value) { return sink(mapper(value)); });
+    });
+  }
+
+  // First count elements, source isn't read any further after that
+  inline auto take(size_t count) const {
+    return makeView<T>([source = m_source, count](auto&& sink) mutable {
+      size_t left = count;
+      if (!left) return;
+      source([&](const T& value) { return sink(value) && --left > 0; });
+    });
+  }
+
+  inline auto skip(size_t count) const {
+    return makeView<T>([source = m_source, count](auto&& sink) mutable {
+      size_t skipped = 0;
+      source([&](const T& value) { return skipped < count ? (skipped++, true) : sink(value); });
+    });
+  }
+
+  template <Consumer<const T&> F>
+  inline void foreach(F f) const {
+    run([&f](const T& value) { f(value); return true; });
+  }
+
+  template <typename R = T, Callable<R, R, const T&> F>
+  inline R reduce(F reducer, R startValue = {}) const {
+    R result = startValue;
+    run([&result, &reducer](const T& value) { result = reducer(result, value); return true; });
+    return result;
+  }
+
+  inline size_t count() const {
+    size_t result = 0;
+    run([&result](const T&) { result++; return true; });
+    return result;
+  }
+
+  // Materializes the view into any collection with append(), Array by default
+  template <typename C = Array<T, DefaultAllocator, DoublingGrowth>>
+  inline C collect() const {
+    C result;
+    run([&result](const T& value) { result.append(value); return true; });
+    return result;
+  }
+
+ private:
+  // Source is copied, so stages with state (take, skip, mutable lambdas) start fresh every run
+  template <typename F>
+  inline void run(F sink) const {
+    S source = m_source;
+    source(sink);
+  }
+
+ private:
+  S m_source;
+};
+
+} /* namespace mrt */
+
+#endif /* _MRT_COLLECTIONS_VIEW_H_ */
@@ -0,0 +1,243 @@
+#include "test.h"
+#include <mrt/allocator.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <mrt/map.h>
+#include <mrt/flat_map.h>
+#include <mrt/deque.h>
+#include <mrt/segmented_array.h>
+#include <type_traits>
+#include <cstdint>
+#include <cstdio>
+
+struct Counters {
+  size_t allocations = 0;
+  size_t deallocations = 0;
+};
+
+struct CountingAllocator {
+  Counters* counters;
+
+  inline CountingAllocator(Counters& counters) : counters(&counters) {}
+
+  inline void* allocate(size_t size, size_t alignment) {
+    counters->allocations++;
+    return mrt::DefaultAllocator().allocate(size, alignment);
+  }
+
+  inline void deallocate(void* ptr, size_t size, size_t alignment) {
+    counters->deallocations++;
+    mrt::DefaultAllocator().deallocate(ptr, size, alignment);
+  }
+
+  inline bool operator==(const CountingAllocator& rhs) const { return counters == rhs.counters; }
+};
+
+bool test_arena_alignment() {
+  mrt::MonotonicArena arena(64);
+
+  arena.allocate(1, 1);
+  void* p1 = arena.allocate(8, 8);
+  arena.allocate(3, 1);
+  void* p2 = arena.allocate(16, 16);
+  void* p3 = arena.allocate(1000, 8);
+
+  return (uintptr_t) p1 % 8 == 0 && (uintptr_t) p2 % 16 == 0 && (uintptr_t) p3 % 8 == 0
+      && arena.allocated() == 1028 && arena.reserved() >= 1028;
+}
+
+bool test_arena_release() {
+  mrt::MonotonicArena arena;
+
+  for (int i = 0; i < 100; i++) {
+    arena.allocate(1024, 8);
+  }
+  arena.release();
+
+  return arena.allocated() == 0 && arena.reserved() == 0;
+}
+
+bool test_arena_reset() {
+  mrt::MonotonicArena arena(64);
+
+  for (int i = 0; i < 10; i++) {
+    arena.allocate(1024, 8);
+  }
+  size_t reserved = arena.reserved();
+  arena.reset();
+  arena.allocate(1024, 8);
+
+  return arena.allocated() == 1024 && arena.reserved() < reserved && arena.reserved() >= 1024;
+}
+
+bool test_array() {
+  mrt::MonotonicArena arena;
+  mrt::Array<int, mrt::ArenaAllocator> arr(arena);
+
+  for (int i = 0; i < 1000; i++) {
+    arr.append(i);
+  }
+  auto even = arr.filter([](auto x) { return x % 2 == 0; });
+
+  return arr.size() == 1000 && arr[999] == 999 && even.size() == 500
+      && even.allocator() == arr.allocator() && arena.allocated() > 1000 * sizeof(int);
+}
+
+bool test_array_move() {
+  mrt::MonotonicArena arena1, arena2;
+  mrt::Array<int, mrt::ArenaAllocator> arr1 = {{0, 1, 2}, arena1};
+  mrt::Array<int, mrt::ArenaAllocator> arr2(arena2);
+
+  arr2 = std::move(arr1);
+
+  return arr2.size() == 3 && arr2[2] == 2 && arr2.allocator() == mrt::ArenaAllocator(arena2);
+}
+
+// Moves between allocators copy, so they can throw
+static_assert(!std::is_nothrow_move_assignable_v<mrt::FlatMap<int, int, mrt::ArenaAllocator>>);
+static_assert(!std::is_nothrow_move_assignable_v<mrt::Deque<int, mrt::ArenaAllocator>>);
+static_assert(!std::is_nothrow_move_assignable_v<mrt::SegmentedArray<int, mrt::ArenaAllocator>>);
+
+bool test_flat_map_move() {
+  mrt::MonotonicArena arena1, arena2;
+  mrt::FlatMap<int, int, mrt::ArenaAllocator> map1(arena1), map2(arena2), map3(arena1);
+  for (int i = 0; i < 20; i++) {
+    map1.set(i, i * 10);
+  }
+
+  map2 = std::move(map1);
+  bool copied = map2.size() == 20 && map2[7] == 70 && map2.allocator() == mrt::ArenaAllocator(arena2) && map1.size() == 0;
+  map3 = std::move(map2);
+
+  return copied && map3.size() == 20 && map3[19] == 190 && map2.size() == 0;
+}
+
+bool test_deque_move() {
+  mrt::MonotonicArena arena1, arena2;
+  mrt::Deque<int, mrt::ArenaAllocator> deque1(arena1), deque2(arena2);
+  for (int i = 0; i < 100; i++) {
+    deque1.append(i);
+  }
+
+  deque2 = std::move(deque1);
+
+  return deque2.size() == 100 && deque2[99] == 99 && deque2.allocator() == mrt::ArenaAllocator(arena2) && deque1.size() == 0;
+}
+
+bool test_segmented_array_move() {
+  mrt::MonotonicArena arena1, arena2;
+  mrt::SegmentedArray<int, mrt::ArenaAllocator> arr1(arena1), arr2(arena2);
+  for (int i = 0; i < 100; i++) {
+    arr1.append(i);
+  }
+
+  arr2 = std::move(arr1);
+
+  return arr2.size() == 100 && arr2[99] == 99 && arr2.allocator() == mrt::ArenaAllocator(arena2) && arr1.size() == 0;
+}
+
+bool test_list() {
+  mrt::MonotonicArena arena;
+  mrt::List<int, mrt::ArenaAllocator> list(arena);
+
+  for (int i = 0; i < 10; i++) {
+    list.append(i);
+  }
+  list.remove(0);
+
+  return list.size() == 9 && list[0] == 1 && arena.allocated() == 10 * sizeof(mrt::List<int>::Node);
+}
+
+bool test_map() {
+  mrt::MonotonicArena arena;
+  mrt::Map<int, int, mrt::ArenaAllocator> map(arena);
+
+  for (int i = 0; i < 16; i++) {
+    map.set(i, i * 10);
+  }
+  auto keys = map.keys();
+
+  return map[5] == 50 && keys.size() == 16 && keys.allocator() == map.allocator();
+}
+
+bool test_list_balanced() {
+  Counters counters;
+  {
+    mrt::List<int, CountingAllocator> list(counters);
+    for (int i = 0; i < 10; i++) {
+      list.append(i);
+    }
+    list.remove(3);
+  }
+
+  return counters.allocations == 10 && counters.deallocations == 10;
+}
+
+bool test_map_balanced() {
+  Counters counters;
+  {
+    mrt::Map<int, int, CountingAllocator> map(counters);
+    for (int i = 0; i < 8; i++) {
+      map.set(i * 32, i);
+    }
+    map.remove(64);
+  }
+
+  return counters.allocations > 0 && counters.allocations == counters.deallocations;
+}
+
+struct alignas(64) Wide {
+  int value;
+
+  bool operator==(const Wide& rhs) const { return value == rhs.value; }
+};
+
+bool aligned(const void* ptr, size_t alignment) {
+  return (uintptr_t) ptr % alignment == 0;
+}
+
+bool test_default_alignment() {
+  mrt::DefaultAllocator allocator;
+  void* small = allocator.allocate(24, 8);
+  void* wide = allocator.allocate(100, 256);
+  bool ok = aligned(small, 8) && aligned(wide, 256);
+  allocator.deallocate(small, 24, 8);
+  allocator.deallocate(wide, 100, 256);
+
+  // Over-aligned elements through every node and buffer path
+  mrt::List<Wide> list;
+  mrt::Map<int, Wide> map;
+  for (int i = 0; i < 100; i++) {
+    list.append(Wide{i});
+    map.set(i, Wide{i});
+  }
+  for (auto& element : list) {
+    ok = ok && aligned(&element, 64);
+  }
+  for (int i = 0; i < 100; i++) {
+    ok = ok && aligned(&map[i], 64) && map[i].value == i;
+  }
+  return ok;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("allocator");
+
+  framework.addTests({
+    {"test_arena_alignment", test_arena_alignment},
+    {"test_arena_release", test_arena_release},
+    {"test_arena_reset", test_arena_reset},
+    {"test_array", test_array},
+    {"test_array_move", test_array_move},
+    {"test_flat_map_move", test_flat_map_move},
+    {"test_deque_move", test_deque_move},
+    {"test_segmented_array_move", test_segmented_array_move},
+    {"test_list", test_list},
+    {"test_map", test_map},
+    {"test_list_balanced", test_list_balanced},
+    {"test_map_balanced", test_map_balanced},
+    {"test_default_alignment", test_default_alignment},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -1,5 +1,11 @@
 #include "test.h"
 #include <mrt/array.h>
+#include <mrt/thread_pool.h>
+#include <mrt/list.h>
+#include <cstdint>
+#include <string>
+#include <functional>
+#include <cmath>
 #include <cstdio>
 
 bool test_copy() {
@@ -80,6 +86,37 @@ bool test_resize() {
   return arr == expected;
 }
 
+bool test_emplace() {
+  mrt::Array<std::string> arr;
+
+  arr.emplace(3, 'a');
+  arr.emplace("bc");
+
+  return arr.size() == 2 && arr[0] == "aaa" && arr[1] == "bc";
+}
+
+bool test_append_move() {
+  mrt::Array<std::string> arr;
+  std::string s = "abc";
+
+  arr.append(std::move(s));
+
+  return arr.size() == 1 && arr[0] == "abc";
+}
+
+bool test_resize_nontrivial() {
+  mrt::Array<std::string> arr;
+
+  for (int i = 0; i < 100; i++) {
+    arr.append(std::to_string(i));
+  }
+  arr.insert(50, "x");
+  arr.prepend("y");
+  arr.remove(0, 2);
+
+  return arr.size() == 100 && arr[0] == "1" && arr[49] == "x" && arr[99] == "99";
+}
+
 bool test_reserve() {
   mrt::Array<int> arr;
 
@@ -141,6 +178,41 @@ bool test_rfind() {
   return arr.rfind(1) == 7;
 }
 
+// Match in every position of arrays around vector register sizes, checked against plain loops
+template <typename T>
+bool checkSearch() {
+  for (size_t size = 0; size < 150; size++) {
+    mrt::Array<T> arr;
+    for (size_t i = 0; i < size; i++) {
+      arr.append((T) (i % 7 + 1));
+    }
+    for (size_t i = 0; i <= 8; i++) {
+      size_t first = mrt::nidx, last = mrt::nidx, count = 0;
+      for (size_t j = 0; j < size; j++) {
+        if (arr[j] != (T) i) continue;
+        if (first == mrt::nidx) first = j;
+        last = j;
+        count++;
+      }
+      if (arr.contains((T) i) != (first != mrt::nidx)) return false;
+      if (arr.lfind((T) i) != first || arr.rfind((T) i) != last) return false;
+      auto indexes = arr.find((T) i);
+      if (indexes.size() != count || (count && (indexes[0] != first || indexes[count-1] != last))) return false;
+    }
+  }
+  return true;
+}
+
+bool test_search_simd() {
+  mrt::Array<double> floats = {1.0, -0.0, NAN, 2.0};
+  mrt::Array<int> ints = {5, 1, 5, 1, 5, 1, 5, 1, 5, 1, 5, 1, 5, 1, 5, 1, 5, 1, 5};
+
+  return checkSearch<int8_t>() && checkSearch<uint16_t>() && checkSearch<int>() && checkSearch<uint64_t>()
+      && checkSearch<float>() && checkSearch<double>()
+      && floats.contains(0.0) && !floats.contains(NAN)
+      && ints.lfind(5, 3) == 4 && ints.rfind(5, 17) == 16 && ints.find(1, 10).size() == 4 && ints.lfind(5, 100) == mrt::nidx;
+}
+
 bool test_unique() {
   mrt::Array<int> arr = {0, 1, 2, 3, 1, 5, 6, 1};
   mrt::Array<int> expected = {0, 1, 2, 3, 5, 6};
@@ -210,6 +282,60 @@ bool test_map() {
   return arr.map<std::string>([](auto x) { return std::to_string(x); }) == expected;
 }
 
+bool test_callables() {
+  mrt::Array<int> arr = {3, 1, 2};
+  mrt::Array<int> expected = {3, 2, 1};
+  std::function<bool(const int&)> pred = [](const int& x) { return x > 1; };
+
+  arr.sort([](int& lhs, int& rhs) { return lhs > rhs; });
+
+  return arr == expected && arr.filter(pred).size() == 2 && arr.sorted().reduce(+[](int s, const int& x) { return s * 10 + x; }) == 123;
+}
+
+bool test_parallel_map() {
+  mrt::ThreadPool pool(4);
+  mrt::Array<int> arr;
+  for (int i = 0; i < 100000; i++) {
+    arr.append(i);
+  }
+
+  auto result = arr.parallelMap<std::string>([](auto x) { return std::to_string(x); }, pool);
+
+  return result.size() == arr.size() && result[0] == "0" && result[99999] == "99999"
+      && result == arr.map<std::string>([](auto x) { return std::to_string(x); });
+}
+
+bool test_parallel_filter() {
+  mrt::ThreadPool pool(4);
+  mrt::Array<int> arr;
+  for (int i = 0; i < 100000; i++) {
+    arr.append(i);
+  }
+
+  auto pred = [](auto x) { return x % 3 == 0; };
+
+  return arr.parallelFilter(pred, pool) == arr.filter(pred) && mrt::Array<int>().parallelFilter(pred, pool).size() == 0;
+}
+
+bool test_parallel_reduce() {
+  mrt::ThreadPool pool(4);
+  mrt::Array<int> arr;
+  for (int i = 0; i < 100000; i++) {
+    arr.append(i % 1000);
+  }
+
+  // Concatenation isn't commutative, so this checks that partial results are combined in order
+  mrt::Array<int> small = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  auto digits = small.parallelReduce<std::string>(
+    [](std::string s, auto x) { return s + std::to_string(x); },
+    [](std::string a, std::string b) { return a + b; },
+    "", pool
+  );
+
+  return arr.parallelReduce<long>([](long s, auto x) { return s + x; }, [](long a, long b) { return a + b; }, 0, pool) == 49950000
+      && digits == "123456789";
+}
+
 bool test_get() {
   mrt::Array<int> arr = {0, 1, 2, 3, 4};
 
@@ -254,6 +380,43 @@ bool test_or() {
   return (arr | arr2) == expected;
 }
 
+// Only ==, so neither hashing nor the sorted path applies
+struct Point {
+  int x, y;
+  bool operator==(const Point& rhs) const { return x == rhs.x && y == rhs.y; }
+};
+
+bool test_set_ops_paths() {
+  mrt::Array<int> sorted = {1, 1, 2, 4, 4, 4, 7};
+  mrt::Array<int> sorted2 = {0, 2, 4, 8};
+  mrt::Array<int> uniqueSorted = {1, 2, 4, 7};
+  mrt::Array<int> andSorted = {2, 4, 4, 4};
+  mrt::Array<int> orSorted = {1, 1, 7};
+  mrt::Array<double> zeros = {0.0, -0.0, 1.0, 0.0};
+  mrt::Array<double> uniqueZeros = {0.0, 1.0};
+  mrt::Array<Point> points = {{1, 2}, {3, 4}, {1, 2}};
+  mrt::Array<Point> uniquePoints = {{1, 2}, {3, 4}};
+
+  return sorted.unique() == uniqueSorted && (sorted & sorted2) == andSorted && (sorted | sorted2) == orSorted
+      && zeros.unique() == uniqueZeros && points.unique() == uniquePoints && (points | uniquePoints).size() == 0;
+}
+
+bool test_unique_large() {
+  mrt::Array<int> arr;
+  mrt::Array<int> odd;
+  for (int i = 0; i < 100000; i++) {
+    arr.append((i * 7919) % 1000);
+    if (i % 2) odd.append(i % 1000);
+  }
+
+  auto unique = arr.unique();
+  auto common = arr & odd;
+  auto rest = arr | odd;
+
+  return unique.size() == 1000 && unique.get(0, -1) == 0 && unique.get(1, -1) == 919
+      && common.size() == 50000 && rest.size() == 50000 && common.unique().size() == 500;
+}
+
 bool test_iterators() {
   mrt::Array<int> arr = {0, 1, 2, 3, 4};
 
@@ -266,6 +429,88 @@ bool test_iterators() {
   return true;
 }
 
+bool test_emplace_throws() {
+  mrt::Array<std::string> arr;
+  arr.append("a");
+
+  try {
+    arr.emplace(nullptr, 1);
+  } catch (std::exception& e) {}
+
+  return arr.size() == 1 && arr[0] == "a";
+}
+
+bool test_growth_policy() {
+  mrt::Array<int, mrt::DefaultAllocator, mrt::LinearGrowth<100>> linear;
+  mrt::Array<int, mrt::DefaultAllocator, mrt::GeometricGrowth<3, 2>> geometric;
+  mrt::Array<int> doubling;
+
+  for (int i = 0; i < 1000; i++) {
+    linear.append(i);
+    geometric.append(i);
+    doubling.append(i);
+  }
+
+  // 8, 108, ..., 1008 and 8, 12, 18, ..., 1021
+  return linear.capacity() == 1008 && linear.stats().reallocations == 10
+    && doubling.capacity() == 1024 && doubling.stats().reallocations == 7
+    && geometric.capacity() == 1021 && geometric.stats().reallocations == 12 && geometric[999] == 999
+    && mrt::ArrayView<int>(linear) == doubling.view();
+}
+
+bool test_memory_stats() {
+  mrt::Array<int64_t> arr;
+  for (int i = 0; i < 100; i++) {
+    arr.append(i);
+  }
+  mrt::MemoryStats stats = arr.stats();
+
+  mrt::Array<int64_t> moved = std::move(arr);
+
+  return stats.allocated == 128 * sizeof(int64_t) && stats.live == 100 * sizeof(int64_t)
+    && stats.slack() == 28 * sizeof(int64_t) && stats.nodes == 0 && stats.reallocations == 4
+    && moved.stats().reallocations == 4 && arr.memoryUsage() == 0;
+}
+
+struct alignas(64) Wide {
+  int value;
+
+  bool operator==(const Wide& rhs) const { return value == rhs.value; }
+};
+
+bool test_over_aligned() {
+  mrt::Array<Wide> arr;
+  bool aligned = true;
+
+  // Every reallocation has to keep the buffer aligned for Wide
+  for (int i = 0; i < 1000; i++) {
+    arr.append(Wide{i});
+    aligned = aligned && (uintptr_t) arr.data() % alignof(Wide) == 0;
+  }
+  mrt::Array<Wide> copy = arr;
+  copy.reserve(5000);
+
+  return aligned && (uintptr_t) copy.data() % alignof(Wide) == 0 && copy == arr && arr[999].value == 999;
+}
+
+bool test_merge_sort_callables() {
+  mrt::Array<int> arr = {3, 1, 2, 5, 4};
+  mrt::List<int> list = {3, 1, 2, 5, 4};
+  mrt::SortComparator<int> descending = [](int& lhs, int& rhs) { return lhs > rhs; };
+  bool ok = true;
+
+  // Function objects, function pointers and std::function comparators
+  mrt::MergeSort().sort(mrt::Descending<int>(), arr);
+  ok = ok && arr == mrt::Array<int>{5, 4, 3, 2, 1};
+  mrt::MergeSort().sort(mrt::asc<int>, arr);
+  ok = ok && arr == mrt::Array<int>{1, 2, 3, 4, 5};
+  mrt::MergeSort().sort(descending, arr);
+  ok = ok && arr == mrt::Array<int>{5, 4, 3, 2, 1};
+  mrt::MergeSort().sort(mrt::Ascending<int>(), list);
+
+  return ok && list == mrt::List<int>{1, 2, 3, 4, 5};
+}
+
 int main(int argc, char ** argv) {
   mrt::TestFramework framework("array");
 
@@ -278,6 +523,9 @@ int main(int argc, char ** argv) {
     {"test_remove", test_remove},
     {"test_remove_many", test_remove_many},
     {"test_resize", test_resize},
+    {"test_emplace", test_emplace},
+    {"test_append_move", test_append_move},
+    {"test_resize_nontrivial", test_resize_nontrivial},
     {"test_reserve", test_reserve},
     {"test_clear", test_clear},
     {"test_empty", test_empty},
@@ -287,6 +535,7 @@ int main(int argc, char ** argv) {
     {"test_find", test_find},
     {"test_lfind", test_lfind},
     {"test_rfind", test_rfind},
+    {"test_search_simd", test_search_simd},
     {"test_unique", test_unique},
     {"test_reverse", test_reverse},
     {"test_sort_asc", test_sort_asc},
@@ -296,13 +545,24 @@ int main(int argc, char ** argv) {
     {"test_reduce", test_reduce},
     {"test_reduceRight", test_reduceRight},
     {"test_map", test_map},
+    {"test_callables", test_callables},
+    {"test_parallel_map", test_parallel_map},
+    {"test_parallel_filter", test_parallel_filter},
+    {"test_parallel_reduce", test_parallel_reduce},
     {"test_get", test_get},
     {"test_equals", test_equals},
     {"test_notequals", test_notequals},
     {"test_combine", test_combine},
     {"test_and", test_and},
     {"test_or", test_or},
+    {"test_set_ops_paths", test_set_ops_paths},
+    {"test_unique_large", test_unique_large},
     {"test_iterators", test_iterators},
+    {"test_emplace_throws", test_emplace_throws},
+    {"test_growth_policy", test_growth_policy},
+    {"test_memory_stats", test_memory_stats},
+    {"test_over_aligned", test_over_aligned},
+    {"test_merge_sort_callables", test_merge_sort_callables},
   });
 
   return framework.run(argc, argv);
@@ -0,0 +1,119 @@
+#include "test.h"
+#include <mrt/array_view.h>
+#include <mrt/string.h>
+#include <mrt/array.h>
+#include <cstdio>
+
+bool test_view() {
+  mrt::Array<int> arr = {0, 1, 2, 3, 4, 5};
+  auto view = arr.view(1, 4);
+
+  return view.size() == 3 && view[0] == 1 && view[2] == 3 && view.data() == arr.data() + 1;
+}
+
+bool test_clamp() {
+  mrt::Array<int> arr = {0, 1, 2, 3};
+
+  return arr.view().size() == 4 && arr.view(2).size() == 2 && arr.view(1, 100).size() == 3
+      && arr.view(10, 20).size() == 0 && arr.view(3, 1).size() == 0;
+}
+
+bool test_iterate() {
+  mrt::Array<int> arr = {1, 2, 3, 4};
+  int sum = 0;
+
+  for (auto& x : arr.view(1, 3)) {
+    sum += x;
+  }
+
+  return sum == 5;
+}
+
+bool test_search() {
+  mrt::Array<int> arr = {5, 1, 2, 1, 5, 1, 7};
+  auto view = arr.view(1, 6);
+
+  return view.contains(5) && !view.contains(7) && view.lfind(1) == 0 && view.rfind(1) == 4
+      && view.find(1).size() == 3 && view.find(1)[1] == 2 && view.lfind(1, 1) == 2;
+}
+
+bool test_binary_search() {
+  mrt::Array<int> arr = {1, 3, 3, 5, 8, 13};
+  auto view = arr.view(1);
+
+  return view.binarySearch(5) == 2 && view.binarySearch(4) == mrt::nidx && view.lowerBound(3) == 0
+      && view.lowerBound(100) == 5 && arr.binarySearch(1) == 0 && arr.binarySearch(13) == 5;
+}
+
+bool test_reduce() {
+  mrt::Array<int> arr = {1, 2, 3, 4, 5};
+
+  return arr.view(1, 4).reduce([](int s, const int& x) { return s + x; }) == 9;
+}
+
+bool test_compare() {
+  mrt::Array<int> arr = {0, 1, 2, 3, 1, 2};
+  mrt::Array<int> expected = {1, 2};
+
+  return arr.view(1, 3) == arr.view(4, 6) && arr.view(1, 3) == expected && expected == arr.view(4)
+      && arr.view(0, 2) != expected && arr.view(1, 4) != expected;
+}
+
+bool test_copy() {
+  mrt::Array<int> arr = {0, 1, 2, 3};
+  mrt::Array<int> expected = {1, 2};
+  mrt::Array<int> copy(arr.view(1, 3));
+
+  return copy == expected && arr.view(1, 3).collect() == expected && arr.slice(1, 3) == expected && arr.slice(2) == mrt::Array<int>{0, 1};
+}
+
+bool test_append_self() {
+  mrt::Array<int> arr = {0, 1, 2, 3, 4, 5, 6};
+  mrt::Array<int> expected = {0, 1, 2, 3, 4, 5, 6, 2, 3, 4};
+
+  // Appending grows the buffer the view points into
+  arr += arr.view(2, 5);
+
+  return arr == expected;
+}
+
+bool test_take_skip() {
+  mrt::Array<int> arr = {0, 1, 2, 3, 4, 5};
+  mrt::Array<int> expected = {2, 3};
+
+  return arr.view().skip(2).take(2) == expected && arr.view().take(100).size() == 6 && arr.view().skip(100).count() == 0;
+}
+
+bool test_lazy() {
+  mrt::Array<int> arr = {0, 1, 2, 3, 4, 5, 6};
+  mrt::Array<int> expected = {10, 30};
+
+  return arr.view(1).filter([](const int& x) { return x % 2; }).map([](const int& x) { return x * 10; }).take(2).collect() == expected;
+}
+
+bool test_string_find() {
+  mrt::String s = "abcabd abd";
+
+  return s.find("abd") == 3 && s.find("abd", 4) == 7 && s.find("abe") == mrt::nidx && s.find("bd a") == 4 && s.find("d abdx") == mrt::nidx;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("array_view");
+
+  framework.addTests({
+    {"test_view", test_view},
+    {"test_clamp", test_clamp},
+    {"test_iterate", test_iterate},
+    {"test_search", test_search},
+    {"test_binary_search", test_binary_search},
+    {"test_reduce", test_reduce},
+    {"test_compare", test_compare},
+    {"test_copy", test_copy},
+    {"test_append_self", test_append_self},
+    {"test_take_skip", test_take_skip},
+    {"test_lazy", test_lazy},
+    {"test_string_find", test_string_find},
+  });
+
+  return framework.run(argc, argv);
+}
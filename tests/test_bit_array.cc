@@ -0,0 +1,134 @@
+#include "test.h"
+#include <mrt/bit_array.h>
+#include <mrt/array.h>
+#include <cstdio>
+
+// Set bits at multiples of step
+mrt::BitArray every(size_t size, size_t step) {
+  mrt::BitArray bits(size);
+  for (size_t i = 0; i < size; i += step) {
+    bits.set(i);
+  }
+  return bits;
+}
+
+bool test_append_get() {
+  mrt::BitArray bits;
+  for (size_t i = 0; i < 200; i++) {
+    bits.append(i % 3 == 0);
+  }
+
+  for (size_t i = 0; i < 200; i++) {
+    if (bits[i] != (i % 3 == 0)) return false;
+  }
+  return bits.size() == 200 && bits.words().size() == 4 && bits.count() == 67;
+}
+
+bool test_set_flip() {
+  mrt::BitArray bits(130);
+  bits.set(0);
+  bits.set(64);
+  bits.set(129);
+  bits.flip(64);
+  bits.flip(65);
+  bits.reset(0);
+
+  return bits.count() == 2 && bits[65] && bits[129] && !bits[0] && !bits[64];
+}
+
+bool test_resize() {
+  mrt::BitArray bits(10, true);
+  bits.resize(100, false);
+  bits.resize(150, true);
+  bits.resize(120);
+
+  return bits.size() == 120 && bits.count() == 10 + 20 && bits[9] && !bits[10] && bits[100] && bits[119];
+}
+
+bool test_pop() {
+  mrt::BitArray bits = {true, false, true};
+  bool last = bits.pop();
+  bool middle = bits.pop();
+
+  return last && !middle && bits.size() == 1 && bits.count() == 1;
+}
+
+bool test_find() {
+  mrt::BitArray bits = every(300, 70);
+
+  return bits.findFirst() == 0 && bits.findNext(1) == 70 && bits.findNext(71) == 140
+    && bits.findNext(281) == mrt::nidx && bits.rfind(true) == 280 && bits.rfind(true, 279) == 210
+    && bits.lfind(false) == 1 && bits.rfind(false) == 299 && bits.find(true) == mrt::Array<size_t>{0, 70, 140, 210, 280};
+}
+
+bool test_find_tail() {
+  mrt::BitArray ones(100, true);
+  mrt::BitArray zeros(100);
+
+  return ones.lfind(false) == mrt::nidx && !ones.contains(false) && ones.all()
+    && zeros.findFirst() == mrt::nidx && zeros.none() && zeros.rfind(true) == mrt::nidx
+    && mrt::BitArray().rfind(true) == mrt::nidx;
+}
+
+bool test_foreach_set() {
+  mrt::BitArray bits = every(1000, 7);
+  mrt::Array<size_t> indexes;
+  bits.foreachSet([&indexes](size_t i) { indexes.append(i); });
+
+  return indexes == bits.find(true) && indexes.size() == 143 && indexes[142] == 994;
+}
+
+bool test_bitwise() {
+  mrt::BitArray twos = every(200, 2);
+  mrt::BitArray threes = every(200, 3);
+
+  return (twos & threes) == every(200, 6) && (twos | threes).count() == 100 + 67 - 34
+    && (twos ^ threes).count() == 100 + 67 - 2 * 34 && (~twos).count() == 100
+    && (~twos).size() == 200 && (~~twos) == twos;
+}
+
+bool test_mismatched() {
+  try {
+    mrt::BitArray(10) &= mrt::BitArray(11);
+  } catch (mrt::BitArray::MismatchedSizesException& e) {
+    return true;
+  }
+  return false;
+}
+
+bool test_convert() {
+  mrt::Array<bool> flags = {true, false, false, true, true};
+  mrt::BitArray bits(flags);
+
+  return bits.toArray() == flags && bits.count() == 3;
+}
+
+bool test_iterate() {
+  mrt::BitArray bits = {true, false, true};
+  size_t set = 0, total = 0;
+  for (bool bit : bits) {
+    set += bit;
+    total++;
+  }
+  return set == 2 && total == 3;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("bit_array");
+
+  framework.addTests({
+    {"test_append_get", test_append_get},
+    {"test_set_flip", test_set_flip},
+    {"test_resize", test_resize},
+    {"test_pop", test_pop},
+    {"test_find", test_find},
+    {"test_find_tail", test_find_tail},
+    {"test_foreach_set", test_foreach_set},
+    {"test_bitwise", test_bitwise},
+    {"test_mismatched", test_mismatched},
+    {"test_convert", test_convert},
+    {"test_iterate", test_iterate},
+  });
+
+  return framework.run(argc, argv);
+}
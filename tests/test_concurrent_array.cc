@@ -0,0 +1,232 @@
+#include "test.h"
+#include <mrt/concurrent_array.h>
+#include <mrt/bit_array.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <new>
+
+constexpr int THREADS = 4;
+constexpr int ITERATIONS = 10000;
+
+bool test_append() {
+  mrt::ConcurrentArray<int> arr;
+
+  for (int i = 0; i < 1000; i++) {
+    if (arr.append(i) != (size_t) i) return false;
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    if (arr[i] != i) return false;
+  }
+
+  return arr.size() == 1000 && arr.capacity() >= 1000 && arr.get(1000, -1) == -1;
+}
+
+bool test_stable_addresses() {
+  mrt::ConcurrentArray<std::string> arr = {"first"};
+  const std::string* first = &arr[0];
+
+  for (int i = 0; i < 5000; i++) {
+    arr.emplace(std::to_string(i));
+  }
+
+  return first == &arr[0] && *first == "first" && arr[5000] == "4999";
+}
+
+bool test_snapshot() {
+  mrt::ConcurrentArray<std::string> arr = {"a", "b", "c"};
+  mrt::Array<std::string> snapshot = arr.snapshot();
+  arr.append("d");
+
+  std::string joined;
+  arr.foreach([&joined](const std::string& s) { joined += s; });
+
+  return snapshot == mrt::Array<std::string>{"a", "b", "c"} && joined == "abcd"
+    && arr.view().filter([](const std::string& s) { return s != "b"; }).count() == 3;
+}
+
+bool test_concurrent_append() {
+  mrt::ConcurrentArray<int> arr;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&arr, t]() {
+      for (int i = 0; i < ITERATIONS; i++) {
+        arr.append(t * ITERATIONS + i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Every value lands exactly once
+  mrt::BitArray seen(THREADS * ITERATIONS);
+  arr.foreach([&seen](const int& value) { seen.set(value); });
+
+  return arr.size() == THREADS * ITERATIONS && seen.all();
+}
+
+bool test_concurrent_read() {
+  mrt::ConcurrentArray<std::string> arr;
+  std::vector<std::thread> threads;
+  std::atomic<bool> done = false;
+  std::atomic<bool> failed = false;
+
+  // Published elements are always fully constructed, whatever the producers are doing
+  std::thread reader([&arr, &done, &failed]() {
+    while (!done) {
+      size_t count = 0;
+      arr.foreach([&count, &failed](const std::string& s) {
+        if (s.size() != 16) failed = true;
+        count++;
+      });
+      if (count > arr.size()) failed = true;
+    }
+  });
+
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&arr, t]() {
+      for (int i = 0; i < ITERATIONS; i++) {
+        arr.emplace(16, 'a' + t);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  done = true;
+  reader.join();
+
+  return !failed && arr.size() == THREADS * ITERATIONS;
+}
+
+struct CountingAllocator {
+  std::atomic<size_t>* allocations;
+
+  inline CountingAllocator(std::atomic<size_t>& allocations) : allocations(&allocations) {}
+
+  inline void* allocate(size_t size, size_t alignment) {
+    (*allocations)++;
+    return mrt::DefaultAllocator().allocate(size, alignment);
+  }
+
+  inline void deallocate(void* ptr, size_t size, size_t alignment) {
+    (*allocations)--;
+    mrt::DefaultAllocator().deallocate(ptr, size, alignment);
+  }
+
+  inline bool operator==(const CountingAllocator& rhs) const { return allocations == rhs.allocations; }
+};
+
+bool test_allocator() {
+  std::atomic<size_t> allocations = 0;
+  size_t installed = 0;
+  {
+    mrt::ConcurrentArray<int, CountingAllocator> arr{CountingAllocator(allocations)};
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < THREADS; t++) {
+      threads.emplace_back([&arr, t]() {
+        for (int i = 0; i < ITERATIONS; i++) {
+          arr.append(t * ITERATIONS + i);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    installed = allocations;
+
+    mrt::Array<int, CountingAllocator> snapshot = arr.snapshot();
+    if (snapshot.size() != THREADS * ITERATIONS || allocations != installed + 1) return false;
+  }
+
+  // Segments of 16 << k elements: 0 to 11 hold the elements, 12 was installed ahead
+  return installed == 13 && allocations == 0;
+}
+
+struct FailingAllocator {
+  bool* failing;
+
+  inline FailingAllocator(bool& failing) : failing(&failing) {}
+
+  inline void* allocate(size_t size, size_t alignment) {
+    if (*failing) throw std::bad_alloc();
+    return mrt::DefaultAllocator().allocate(size, alignment);
+  }
+
+  inline void deallocate(void* ptr, size_t size, size_t alignment) {
+    mrt::DefaultAllocator().deallocate(ptr, size, alignment);
+  }
+
+  inline bool operator==(const FailingAllocator& rhs) const { return failing == rhs.failing; }
+};
+
+bool test_allocation_fails() {
+  bool failing = false;
+  mrt::ConcurrentArray<int, FailingAllocator> arr{FailingAllocator(failing)};
+
+  // Segments 0 and 1 hold 48 elements, installing segment 2 ahead fails
+  for (int i = 0; i < 16; i++) {
+    arr.append(i);
+  }
+  failing = true;
+  int appended = 16;
+  for (int i = 16; i < 60; i++) {
+    try {
+      arr.append(i);
+      appended++;
+    } catch (const std::bad_alloc&) {}
+  }
+  if (appended != 48 || arr.size() != 48) return false;
+
+  // Nothing was claimed by the failed appends, later ones are published
+  failing = false;
+  for (int i = 48; i < 100; i++) {
+    arr.append(i);
+  }
+  for (int i = 0; i < 100; i++) {
+    if (arr[i] != i) return false;
+  }
+  return arr.size() == 100;
+}
+
+struct Throwing {
+  Throwing(int value) : value(value) {
+    if (value < 0) throw value;
+  }
+
+  int value = 0;
+};
+
+bool test_emplace_throws() {
+  mrt::ConcurrentArray<Throwing> arr;
+  arr.emplace(1);
+
+  try {
+    arr.emplace(-1);
+  } catch (int) {}
+  arr.emplace(2);
+
+  return arr.size() == 2 && arr[1].value == 2;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("concurrent_array");
+
+  framework.addTests({
+    {"test_append", test_append},
+    {"test_stable_addresses", test_stable_addresses},
+    {"test_snapshot", test_snapshot},
+    {"test_concurrent_append", test_concurrent_append},
+    {"test_concurrent_read", test_concurrent_read},
+    {"test_emplace_throws", test_emplace_throws},
+    {"test_allocator", test_allocator},
+    {"test_allocation_fails", test_allocation_fails},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,132 @@
+#include "test.h"
+#include <mrt/concurrent_map.h>
+#include <mrt/string.h>
+#include <thread>
+#include <vector>
+
+constexpr int THREADS = 4;
+constexpr int ITERATIONS = 10000;
+
+bool test_set() {
+  mrt::ConcurrentMap<mrt::String, int> map;
+
+  map.set("a", 10);
+  map.set("b", 20);
+  map.set("a", 30);
+
+  return map.get("a") == 30 && map.get("b") == 20 && map.size() == 2;
+}
+
+bool test_get() {
+  mrt::ConcurrentMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  try {
+    map.get("d");
+    return false;
+  } catch (const mrt::ConcurrentMap<mrt::String, int>::NoSuchElementException&) {}
+
+  return map.get("a") == 1 && map.get("c") == 3 && map.get("d", 4) == 4;
+}
+
+bool test_remove() {
+  mrt::ConcurrentMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  bool removed = map.remove("b");
+  bool removedTwice = map.remove("b");
+
+  return removed && !removedTwice && !map.contains("b") && map.size() == 2;
+}
+
+bool test_clear() {
+  mrt::ConcurrentMap<int, int> map;
+
+  for (int i = 0; i < 100; i++) {
+    map.set(i, i);
+  }
+  map.clear();
+
+  return map.size() == 0 && !map.contains(0);
+}
+
+bool test_upsert() {
+  mrt::ConcurrentMap<mrt::String, int> map;
+
+  map.upsert("a", 1, [](int& v) { v++; });
+  map.upsert("a", 1, [](int& v) { v++; });
+  map.upsert("b", 5, [](int& v) { v++; });
+
+  return map.get("a") == 2 && map.get("b") == 5;
+}
+
+bool test_foreach() {
+  mrt::ConcurrentMap<int, int> map;
+
+  for (int i = 0; i < 100; i++) {
+    map.set(i, i);
+  }
+
+  int sum = 0;
+  map.foreach([&sum](auto& p) { sum += p._2; });
+
+  return sum == 4950 && map.keys().size() == 100 && map.items().size() == 100;
+}
+
+bool test_concurrent_upsert() {
+  mrt::ConcurrentMap<int, int> map;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&map]() {
+      for (int i = 0; i < ITERATIONS; i++) {
+        map.upsert(i % 100, 1, [](int& v) { v++; });
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  int sum = 0;
+  map.foreach([&sum](auto& p) { sum += p._2; });
+
+  return map.size() == 100 && sum == THREADS * ITERATIONS;
+}
+
+bool test_concurrent_set_remove() {
+  mrt::ConcurrentMap<int, int> map;
+  std::vector<std::thread> threads;
+
+  // Each thread owns a disjoint key range, readers of other ranges run alongside
+  for (int t = 0; t < THREADS; t++) {
+    threads.emplace_back([&map, t]() {
+      for (int i = 0; i < ITERATIONS; i++) {
+        int key = t * ITERATIONS + i;
+        map.set(key, i);
+        map.get((key + ITERATIONS) % (THREADS * ITERATIONS), 0);
+        if (i % 2) map.remove(key);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return map.size() == THREADS * ITERATIONS / 2 && map.contains(0) && !map.contains(1);
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("concurrent_map");
+
+  framework.addTests({
+    {"test_set", test_set},
+    {"test_get", test_get},
+    {"test_remove", test_remove},
+    {"test_clear", test_clear},
+    {"test_upsert", test_upsert},
+    {"test_foreach", test_foreach},
+    {"test_concurrent_upsert", test_concurrent_upsert},
+    {"test_concurrent_set_remove", test_concurrent_set_remove},
+  });
+
+  return framework.run(argc, argv);
+}
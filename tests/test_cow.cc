@@ -0,0 +1,115 @@
+#include "test.h"
+#include <mrt/cow.h>
+#include <mrt/array.h>
+#include <mrt/string.h>
+#include <vector>
+#include <thread>
+#include <cstdio>
+
+mrt::CowArray<int> numbers(int count) {
+  mrt::Array<int> arr;
+  for (int i = 0; i < count; i++) {
+    arr.append(i);
+  }
+  return mrt::CowArray<int>(std::move(arr));
+}
+
+int sum(mrt::CowArray<int> arr) {
+  return arr->reduce([](int acc, const int& x) { return acc + x; });
+}
+
+bool test_share() {
+  mrt::CowArray<int> arr = numbers(100);
+  mrt::CowArray<int> copy = arr;
+  mrt::CowArray<int> other;
+  other = copy;
+
+  int total = sum(arr);
+
+  return arr.refs() == 3 && &arr.get() == &copy.get() && &other.get() == &arr.get()
+    && total == 4950 && copy == other;
+}
+
+bool test_mutate() {
+  mrt::CowArray<int> arr = numbers(10);
+  mrt::CowArray<int> copy = arr;
+  const int* shared = arr->data();
+
+  copy.mutate().append(10);
+  copy.mutate()[0] = -1;
+
+  return !arr.isShared() && !copy.isShared() && arr->data() == shared && arr->size() == 10
+    && (*arr)[0] == 0 && copy->size() == 11 && copy.get()[0] == -1 && arr != copy;
+}
+
+bool test_mutate_unique() {
+  mrt::CowArray<int> arr = numbers(10);
+  const int* data = arr->data();
+
+  arr.mutate()[5] = 50;
+
+  return arr->data() == data && (*arr)[5] == 50;
+}
+
+bool test_take() {
+  mrt::CowArray<int> arr = numbers(10);
+  mrt::CowArray<int> copy = arr;
+  const int* data = arr->data();
+
+  mrt::Array<int> cloned = std::move(copy).take();
+  mrt::Array<int> moved = std::move(arr).take();
+
+  return cloned.data() != data && moved.data() == data && cloned == moved;
+}
+
+bool test_string() {
+  mrt::CowString str(mrt::String("hello"));
+  mrt::CowString copy = str;
+
+  copy.mutate() += " world";
+  const mrt::String& view = str;
+
+  return view == "hello" && copy.get() == "hello world" && str->size() == 5;
+}
+
+bool test_threads() {
+  mrt::CowArray<int> arr = numbers(1000);
+  std::vector<std::thread> threads;
+  std::atomic<bool> failed = false;
+
+  // Every thread copies, reads, mutates and drops its own handles to the shared value
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&arr, &failed, t]() {
+      mrt::CowArray<int> local = arr;
+      for (int i = 0; i < 1000; i++) {
+        mrt::CowArray<int> copy = local;
+        if (sum(copy) != 499500) failed = true;
+        if (i % 100 == 0) {
+          copy.mutate()[0] = t;
+          if ((*copy)[0] != t || (*local)[0] != 0) failed = true;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return !failed && arr.refs() == 1 && (*arr)[0] == 0;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("cow");
+
+  framework.addTests({
+    {"test_share", test_share},
+    {"test_mutate", test_mutate},
+    {"test_mutate_unique", test_mutate_unique},
+    {"test_take", test_take},
+    {"test_string", test_string},
+    {"test_threads", test_threads},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,184 @@
+#include "test.h"
+#include <mrt/deque.h>
+#include <mrt/array.h>
+#include <string>
+#include <cstdio>
+
+bool test_append_pop() {
+  mrt::Deque<int> deque;
+
+  for (int i = 0; i < 100; i++) {
+    deque.append(i);
+  }
+
+  for (int i = 99; i >= 0; i--) {
+    if (deque.popBack() != i) return false;
+  }
+
+  return deque.isEmpty();
+}
+
+bool test_prepend() {
+  mrt::Deque<int> deque;
+
+  for (int i = 0; i < 100; i++) {
+    deque.prepend(i);
+  }
+
+  for (int i = 0; i < 100; i++) {
+    if (deque[i] != 99 - i) return false;
+  }
+
+  return deque.size() == 100 && deque.front() == 99 && deque.back() == 0;
+}
+
+bool test_queue() {
+  mrt::Deque<int> deque;
+  int next = 0, expected = 0;
+
+  // Head keeps moving forward, so the ring wraps around many times
+  for (int round = 0; round < 1000; round++) {
+    for (int i = 0; i < 5; i++) {
+      deque.append(next++);
+    }
+    for (int i = 0; i < 4; i++) {
+      if (deque.popFront() != expected++) return false;
+    }
+  }
+
+  return deque.size() == 1000 && deque.front() == expected && deque.back() == next - 1;
+}
+
+bool test_wrapped_grow() {
+  mrt::Deque<int> deque;
+
+  for (int i = 0; i < 6; i++) {
+    deque.append(i);
+  }
+  for (int i = 0; i < 4; i++) {
+    deque.popFront();
+  }
+  // Elements now wrap past the end of the buffer when it grows
+  for (int i = 6; i < 20; i++) {
+    deque.append(i);
+  }
+  deque.prepend(3);
+
+  for (size_t i = 0; i < deque.size(); i++) {
+    if (deque[i] != (int) i + 3) return false;
+  }
+
+  return deque.size() == 17;
+}
+
+bool test_strings() {
+  mrt::Deque<std::string> deque;
+
+  for (int i = 0; i < 50; i++) {
+    deque.append("value-" + std::to_string(i));
+    deque.prepend("value-" + std::to_string(-i - 1));
+  }
+
+  for (int i = 0; i < 50; i++) {
+    if (deque.popFront() != "value-" + std::to_string(-50 + i)) return false;
+  }
+
+  mrt::Deque<std::string> copy = deque;
+  mrt::Deque<std::string> moved = std::move(deque);
+
+  return copy == moved && moved.size() == 50 && moved.back() == "value-49" && deque.size() == 0;
+}
+
+bool test_self_reference() {
+  mrt::Deque<std::string> deque;
+
+  deque.append("a");
+  for (int i = 0; i < 20; i++) {
+    deque.append(deque[0]);
+    deque.prepend(deque.back());
+  }
+
+  return deque.size() == 41 && deque.find("a").size() == 41;
+}
+
+bool test_iterate() {
+  mrt::Deque<int> deque;
+
+  for (int i = 0; i < 10; i++) {
+    deque.prepend(i);
+  }
+
+  int expected = 9;
+  for (int x : deque) {
+    if (x != expected--) return false;
+  }
+
+  return expected == -1;
+}
+
+bool test_search() {
+  mrt::Deque<int> deque = {1, 2, 3, 2, 1};
+  deque.prepend(2);
+
+  return deque.contains(3) && !deque.contains(4)
+    && deque.lfind(2) == 0 && deque.lfind(2, 1) == 2 && deque.rfind(2) == 4
+    && deque.find(2) == mrt::Array<size_t>{0, 2, 4};
+}
+
+bool test_functional() {
+  mrt::Deque<int> deque;
+
+  for (int i = 0; i < 10; i++) {
+    deque.prepend(i);
+  }
+
+  auto even = deque.filter([](const int& x) { return x % 2 == 0; });
+  auto squares = deque.map([](const int& x) { return x * x; });
+  int sum = deque.reduce([](int acc, const int& x) { return acc + x; });
+  auto first = deque.view().filter([](const int& x) { return x > 3; }).take(2).collect();
+
+  return even == mrt::Deque<int>{8, 6, 4, 2, 0} && squares[0] == 81 && squares[9] == 0
+    && sum == 45 && first == mrt::Array<int>{9, 8};
+}
+
+bool test_reserve() {
+  mrt::Deque<int> deque;
+
+  deque.reserve(100);
+  size_t capacity = deque.capacity();
+  for (int i = 0; i < 100; i++) {
+    deque.append(i);
+  }
+
+  return capacity == 128 && deque.capacity() == 128;
+}
+
+bool test_memory_stats() {
+  mrt::Deque<int> deque;
+  for (int i = 0; i < 20; i++) {
+    deque.prepend(i);
+  }
+  mrt::MemoryStats stats = deque.stats();
+
+  return stats.allocated == 32 * sizeof(int) && stats.live == 20 * sizeof(int) && stats.reallocations == 2;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("deque");
+
+  framework.addTests({
+    {"test_append_pop", test_append_pop},
+    {"test_prepend", test_prepend},
+    {"test_queue", test_queue},
+    {"test_wrapped_grow", test_wrapped_grow},
+    {"test_strings", test_strings},
+    {"test_self_reference", test_self_reference},
+    {"test_iterate", test_iterate},
+    {"test_search", test_search},
+    {"test_functional", test_functional},
+    {"test_reserve", test_reserve},
+    {"test_memory_stats", test_memory_stats},
+  });
+
+  return framework.run(argc, argv);
+}
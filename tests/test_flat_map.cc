@@ -0,0 +1,253 @@
+#include "test.h"
+#include <mrt/flat_map.h>
+#include <mrt/string.h>
+#include <functional>
+#include <cstdio>
+
+bool test_copy() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+  auto map2 = map;
+
+  return map == map2;
+}
+
+bool test_set() {
+  mrt::FlatMap<mrt::String, int> map;
+
+  map["a"] = 10;
+  map["b"] = 20;
+
+  return map["a"] == 10 && map["b"] == 20;
+}
+
+bool test_get() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  return map["a"] == 1 && map["b"] == 2 && map["c"] == 3;
+}
+
+bool test_remove() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> expected = {{"c", 3}};
+
+  map.remove("b");
+  map.remove("a");
+
+  return map == expected;
+}
+
+bool test_clear() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  map.clear();
+
+  return map.size() == 0 && map.capacity() == 0;
+}
+
+bool test_contains() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  return map.contains("a") && !map.contains("d");
+}
+
+bool test_foreach() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> result;
+
+  map.foreach([&result](auto p) { result[p._1] = p._2; });
+
+  return map == result;
+}
+
+bool test_filter() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}, {"e", 5}, {"f", 6}};
+  mrt::FlatMap<mrt::String, int> expected = {{"d", 4}, {"e", 5}};
+
+  auto result = map.filter([](auto p) { return p._2 > 3 && p._2 < 6; });
+
+  return result == expected;
+}
+
+bool test_reduce() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  auto result = map.reduce<int>([](int r, auto p) { return r + p._2; });
+
+  return result == 6;
+}
+
+bool test_map() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> expected = {{"c", 11}, {"d", 12}, {"e", 13}};
+
+  auto result = map.map<mrt::String, int>(
+    [](const mrt::Pair<mrt::String, int>& p) -> mrt::Pair<mrt::String, int> {
+      char buffer[2] = {0};
+      buffer[0] = p._1[0] + 2;
+      return {mrt::String(buffer), p._2 + 10};
+    }
+  );
+
+  return result == expected;
+}
+
+bool test_equals() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> map2 = {{"b", 2}, {"a", 1}, {"c", 3}};
+
+  return map == map2;
+}
+
+bool test_notequals() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> map2 = {{"b", 2}, {"a", 4}, {"d", 3}};
+
+  return map != map2;
+}
+
+bool test_combine() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}};
+  mrt::FlatMap<mrt::String, int> map2 = {{"c", 3}, {"d", 4}};
+  mrt::FlatMap<mrt::String, int> expected = {{"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}};
+
+  return (map + map2) == expected;
+}
+
+bool test_iterators() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> expected = {{"a", 1}, {"b", 2}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> result;
+
+  for (auto [k, v] : map) {
+    result[k] = v;
+  }
+
+  return result == expected;
+}
+
+enum class E {A, B, C};
+
+bool test_enum_key() {
+  mrt::FlatMap<E, int> map = {{E::A, 10}, {E::B, 20}, {E::C, 30}};
+
+  return map[E::A] == 10;
+}
+
+bool test_get_default() {
+  const mrt::FlatMap<mrt::String, int> map = {{"a", 1}};
+
+  return map.get("a", 0) == 1 && map.get("b", 0) == 0;
+}
+
+bool test_grow() {
+  mrt::FlatMap<int, int> map;
+
+  for (int i = 0; i < 10000; i++) {
+    map.set(i * 7919, i);
+  }
+
+  for (int i = 0; i < 10000; i++) {
+    if (map[i * 7919] != i) return false;
+  }
+
+  return map.size() == 10000 && !map.contains(1) && map.loadFactor() <= 0.875;
+}
+
+bool test_churn() {
+  mrt::FlatMap<int, int> map;
+
+  for (int round = 0; round < 20; round++) {
+    for (int i = 0; i < 1000; i++) {
+      map.set(round * 1000 + i, i);
+    }
+    for (int i = 0; i < 1000; i++) {
+      map.remove(round * 1000 + i);
+    }
+  }
+  map.set(1, 1);
+
+  return map.size() == 1 && map[1] == 1 && map.capacity() < 4096;
+}
+
+bool test_items() {
+  mrt::FlatMap<int, int> map;
+
+  for (int i = 0; i < 100; i++) {
+    map.set(i, i);
+  }
+  map.remove(50);
+
+  int sum = 0, count = 0;
+  for (auto [k, v] : map) {
+    sum += v;
+    count++;
+  }
+
+  return count == 99 && sum == 4950 - 50 && map.keys().size() == 99 && map.items().size() == 99;
+}
+
+bool test_memory_stats() {
+  mrt::FlatMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.set(i, i);
+  }
+  mrt::MemoryStats stats = map.stats();
+
+  return stats.allocated == map.capacity() * (sizeof(mrt::Pair<int, int>) + 1) + mrt::FlatMap<int, int>::GROUP_SIZE
+    && stats.live == 100 * sizeof(mrt::Pair<int, int>) && stats.rehashes == 3 && stats.nodes == 0;
+}
+
+using Entry = mrt::Pair<mrt::String, int>;
+
+struct Positive {
+  bool operator()(const Entry& p) const { return p._2 > 0; }
+};
+
+int sumValues(int s, const Entry& p) {
+  return s + p._2;
+}
+
+bool test_callables() {
+  mrt::FlatMap<mrt::String, int> map = {{"a", 1}, {"b", -2}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> positive = {{"a", 1}, {"c", 3}};
+  mrt::FlatMap<mrt::String, int> result;
+  std::function<void(const Entry&)> copy = [&result](const Entry& p) { result[p._1] = p._2; };
+  std::function<Entry(const Entry&)> negate = [](const Entry& p) -> Entry { return {p._1, -p._2}; };
+
+  // Function objects, function pointers and std::function all go through the same templates
+  map.foreach(copy);
+  auto negated = map.map<mrt::String, int>(negate);
+  return result == map && map.filter(Positive()) == positive && map.filter(std::function<bool(const Entry&)>(Positive())) == positive
+    && map.reduce<int>(sumValues) == 2 && map.reduce<int>(std::function<int(int, const Entry&)>(sumValues)) == 2
+    && negated.size() == 3 && negated["b"] == 2;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("flat_map");
+
+  framework.addTests({
+    {"test_copy", test_copy},
+    {"test_set", test_set},
+    {"test_get", test_get},
+    {"test_remove", test_remove},
+    {"test_clear", test_clear},
+    {"test_contains", test_contains},
+    {"test_foreach", test_foreach},
+    {"test_filter", test_filter},
+    {"test_reduce", test_reduce},
+    {"test_map", test_map},
+    {"test_equals", test_equals},
+    {"test_notequals", test_notequals},
+    {"test_combine", test_combine},
+    {"test_iterators", test_iterators},
+    {"test_enum_key", test_enum_key},
+    {"test_get_default", test_get_default},
+    {"test_grow", test_grow},
+    {"test_churn", test_churn},
+    {"test_items", test_items},
+    {"test_memory_stats", test_memory_stats},
+    {"test_callables", test_callables},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -1,6 +1,8 @@
 #include "test.h"
 #include <mrt/list.h>
 #include <mrt/string.h>
+#include <functional>
+#include <string>
 #include <cstdio>
 
 
@@ -191,6 +193,43 @@ bool test_or() {
   return (arr | arr2) == expected;
 }
 
+// Only ==, so neither hashing nor the sorted path applies
+struct Point {
+  int x, y;
+  bool operator==(const Point& rhs) const { return x == rhs.x && y == rhs.y; }
+};
+
+bool test_set_ops_paths() {
+  mrt::List<int> sorted = {1, 1, 2, 4, 4, 4, 7};
+  mrt::List<int> sorted2 = {0, 2, 4, 8};
+  mrt::List<int> uniqueSorted = {1, 2, 4, 7};
+  mrt::List<int> andSorted = {2, 4, 4, 4};
+  mrt::List<int> orSorted = {1, 1, 7};
+  mrt::List<double> zeros = {0.0, -0.0, 1.0, 0.0};
+  mrt::List<double> uniqueZeros = {0.0, 1.0};
+  mrt::List<Point> points = {{1, 2}, {3, 4}, {1, 2}};
+  mrt::List<Point> uniquePoints = {{1, 2}, {3, 4}};
+
+  return sorted.unique() == uniqueSorted && (sorted & sorted2) == andSorted && (sorted | sorted2) == orSorted
+      && zeros.unique() == uniqueZeros && points.unique() == uniquePoints && (points | uniquePoints).size() == 0;
+}
+
+bool test_unique_large() {
+  mrt::List<int> arr;
+  mrt::List<int> odd;
+  for (int i = 0; i < 100000; i++) {
+    arr.append((i * 7919) % 1000);
+    if (i % 2) odd.append(i % 1000);
+  }
+
+  auto unique = arr.unique();
+  auto common = arr & odd;
+  auto rest = arr | odd;
+
+  return unique.size() == 1000 && unique.get(0, -1) == 0 && unique.get(1, -1) == 919
+      && common.size() == 50000 && rest.size() == 50000 && common.unique().size() == 500;
+}
+
 bool test_iterators() {
   mrt::List<int> arr = {0, 1, 2, 3, 4};
 
@@ -203,6 +242,37 @@ bool test_iterators() {
   return true;
 }
 
+bool test_memory_stats() {
+  mrt::List<int> list = {1, 2, 3};
+  mrt::MemoryStats stats = list.stats();
+
+  return stats.nodes == 3 && stats.allocated == 3 * sizeof(mrt::List<int>::Node)
+    && stats.live == 3 * sizeof(int) && stats.slack() == stats.allocated - stats.live;
+}
+
+struct IsOdd {
+  bool operator()(const int& x) const { return x % 2 == 1; }
+};
+
+int sum(int s, const int& x) {
+  return s + x;
+}
+
+bool test_callables() {
+  mrt::List<int> list = {1, 2, 3, 4, 5};
+  mrt::List<int> odd = {1, 3, 5};
+  std::function<std::string(const int&)> toString = [](const int& x) { return std::to_string(x); };
+  std::function<void(const int&)> append;
+  mrt::List<int> copy;
+  append = [&copy](const int& x) { copy.append(x); };
+
+  // Function objects, function pointers and std::function all go through the same templates
+  list.foreach(append);
+  return list.filter(IsOdd()) == odd && list.filter(std::function<bool(const int&)>(IsOdd())) == odd
+    && list.reduce<int>(sum) == 15 && list.reduce<int>(std::function<int(int, const int&)>(sum)) == 15
+    && list.map<std::string>(toString) == mrt::List<std::string>{"1", "2", "3", "4", "5"} && copy == list;
+}
+
 int main(int argc, char ** argv) {
   mrt::TestFramework framework("list");
 
@@ -231,7 +301,11 @@ int main(int argc, char ** argv) {
     {"test_combine", test_combine},
     {"test_and", test_and},
     {"test_or", test_or},
+    {"test_set_ops_paths", test_set_ops_paths},
+    {"test_unique_large", test_unique_large},
     {"test_iterators", test_iterators},
+    {"test_memory_stats", test_memory_stats},
+    {"test_callables", test_callables},
   });
 
   return framework.run(argc, argv);
@@ -1,6 +1,7 @@
 #include "test.h"
 #include <mrt/map.h>
 #include <mrt/string.h>
+#include <functional>
 #include <cstdio>
 
 bool test_copy() {
@@ -132,6 +133,118 @@ bool test_enum_key() {
   return map[E::A] == 10;
 }
 
+bool test_incremental_resize() {
+  mrt::Map<int, int> map;
+  map.setIncrementalResize(true);
+
+  bool sawResize = false;
+  for (int i = 0; i < 5000; i++) {
+    map.set(i * 31, i);
+    if (map.isResizing()) {
+      sawResize = true;
+      if (!map.contains(0) || map.get(i * 31) != i) return false;
+    }
+  }
+
+  for (int i = 0; i < 5000; i += 2) {
+    map.remove(i * 31);
+  }
+
+  for (int i = 0; i < 5000; i++) {
+    if (map.contains(i * 31) != (i % 2 == 1)) return false;
+  }
+
+  return sawResize && map.size() == 2500 && map.keys().size() == 2500;
+}
+
+bool test_incremental_resize_finish() {
+  mrt::Map<int, int> map;
+  map.setIncrementalResize(true);
+
+  int i = 0;
+  while (!map.isResizing()) {
+    map.set(i, i);
+    i++;
+  }
+  map.setIncrementalResize(false);
+
+  return !map.isResizing() && map.size() == i && map.items().size() == i && map.get(i - 1) == i - 1;
+}
+
+bool test_load_factor() {
+  mrt::Map<int, int> map;
+  for (int i = 0; i < 16; i++) {
+    map.set(i, i);
+  }
+
+  return map.capacity() == 32 && map.loadFactor() == 0.5;
+}
+
+bool test_memory_stats() {
+  mrt::Map<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.set(i, i);
+  }
+  auto stats = map.stats();
+
+  size_t buckets = 0, nodes = 0;
+  for (size_t length = 0; length < stats.chainLengths.size(); length++) {
+    buckets += stats.chainLengths[length];
+    nodes += stats.chainLengths[length] * length;
+  }
+
+  return stats.nodes == 100 && stats.live == 100 * sizeof(mrt::Pair<int, int>)
+    && stats.allocated == map.capacity() * sizeof(void*) + 100 * sizeof(mrt::Map<int, int>::Node)
+    && stats.rehashes == 3 && buckets == map.capacity() && nodes == 100
+    && stats.longestChain == stats.chainLengths.size() - 1 && stats.slack() > 0;
+}
+
+bool test_memory_stats_incremental() {
+  mrt::Map<int, int> map;
+  map.setIncrementalResize(true);
+
+  int i = 0;
+  while (!map.isResizing()) {
+    map.set(i, i);
+    i++;
+  }
+  auto stats = map.stats();
+
+  size_t nodes = 0;
+  for (size_t length = 0; length < stats.chainLengths.size(); length++) {
+    nodes += stats.chainLengths[length] * length;
+  }
+
+  // Both bucket arrays are held while resizing
+  return stats.rehashes == 1 && nodes == map.size()
+    && stats.allocated == (map.capacity() + map.capacity() / 2) * sizeof(void*) + map.size() * sizeof(mrt::Map<int, int>::Node);
+}
+
+using Entry = mrt::Pair<mrt::String, int>;
+
+struct Positive {
+  bool operator()(const Entry& p) const { return p._2 > 0; }
+};
+
+int sumValues(int s, const Entry& p) {
+  return s + p._2;
+}
+
+bool test_callables() {
+  mrt::Map<mrt::String, int> map = {{"a", 1}, {"b", -2}, {"c", 3}};
+  mrt::Map<mrt::String, int> positive = {{"a", 1}, {"c", 3}};
+  mrt::Map<mrt::String, int> result;
+  std::function<void(const Entry&)> copy = [&result](const Entry& p) { result[p._1] = p._2; };
+  std::function<Entry(const Entry&)> negate = [](const Entry& p) -> Entry { return {p._1, -p._2}; };
+
+  // Function objects, function pointers and std::function all go through the same templates
+  map.foreach(copy);
+  auto negated = map.map<mrt::String, int>(negate);
+  return result == map && map.filter(Positive()) == positive && map.filter(std::function<bool(const Entry&)>(Positive())) == positive
+    && map.reduce<int>(sumValues) == 2 && map.reduce<int>(std::function<int(int, const Entry&)>(sumValues)) == 2
+    && negated.size() == 3 && negated["b"] == 2;
+}
+
 int main(int argc, char ** argv) {
   mrt::TestFramework framework("map");
 
@@ -151,6 +264,12 @@ int main(int argc, char ** argv) {
     {"test_combine", test_combine},
     {"test_iterators", test_iterators},
     {"test_enum_key", test_enum_key},
+    {"test_incremental_resize", test_incremental_resize},
+    {"test_incremental_resize_finish", test_incremental_resize_finish},
+    {"test_load_factor", test_load_factor},
+    {"test_memory_stats", test_memory_stats},
+    {"test_memory_stats_incremental", test_memory_stats_incremental},
+    {"test_callables", test_callables},
   });
 
   return framework.run(argc, argv);
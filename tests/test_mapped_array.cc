@@ -0,0 +1,169 @@
+#include "test.h"
+#include <mrt/mapped_array.h>
+#include <mrt/array.h>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+struct Entry {
+  uint64_t key;
+  uint32_t value;
+  float weight;
+
+  bool operator==(const Entry& rhs) const { return key == rhs.key && value == rhs.value && weight == rhs.weight; }
+  bool operator<(const Entry& rhs) const { return key < rhs.key; }
+};
+
+std::string tempPath(const char* name) {
+  return "/tmp/mrt_mapped_" + std::to_string(getpid()) + "_" + name;
+}
+
+bool test_roundtrip() {
+  std::string path = tempPath("roundtrip");
+  mrt::Array<uint64_t> arr;
+  for (uint64_t i = 0; i < 10000; i++) {
+    arr.append(i * i);
+  }
+  arr.save(path.c_str());
+
+  mrt::MappedArray<uint64_t> mapped(path.c_str());
+  bool ok = mapped.size() == arr.size() && mapped == arr && mapped.toArray() == arr;
+  std::remove(path.c_str());
+
+  return ok;
+}
+
+bool test_structs() {
+  std::string path = tempPath("structs");
+  mrt::Array<Entry> arr;
+  for (uint32_t i = 0; i < 100; i++) {
+    arr.append({i * 3ull, i, i / 2.0f});
+  }
+  arr.save(path.c_str());
+
+  mrt::MappedArray<Entry> mapped(path.c_str());
+  size_t index = mapped.binarySearch({42, 0, 0});
+  bool ok = mapped.isSorted() && index == 14 && mapped[index].value == 14
+    && mapped.binarySearch({43, 0, 0}) == mrt::nidx && mapped.lowerBound({43, 0, 0}) == 15;
+  std::remove(path.c_str());
+
+  return ok;
+}
+
+bool test_search() {
+  std::string path = tempPath("search");
+  mrt::Array<int> arr = {5, 1, 5, 2, 5, 3};
+  arr.save(path.c_str());
+
+  mrt::MappedArray<int> mapped(path.c_str());
+  bool ok = mapped.contains(2) && !mapped.contains(4)
+    && mapped.lfind(5, 1) == 2 && mapped.rfind(5) == 4
+    && mapped.find(5) == mrt::Array<size_t>{0, 2, 4}
+    && mapped.reduce([](int acc, const int& x) { return acc + x; }) == 21
+    && mapped.filter([](const int& x) { return x < 5; }) == mrt::Array<int>{1, 2, 3};
+  std::remove(path.c_str());
+
+  return ok;
+}
+
+bool test_empty() {
+  std::string path = tempPath("empty");
+  mrt::Array<double> arr;
+  arr.save(path.c_str());
+
+  mrt::MappedArray<double> mapped(path.c_str());
+  bool ok = mapped.size() == 0 && mapped.begin() == mapped.end();
+  std::remove(path.c_str());
+
+  return ok;
+}
+
+bool test_copy_on_write() {
+  std::string path = tempPath("cow");
+  std::string copyPath = tempPath("cow_saved");
+  mrt::Array<int> arr = {1, 2, 3};
+  arr.save(path.c_str());
+
+  mrt::MappedArray<int> writable(path.c_str(), mrt::MappedArray<int>::Mode::CopyOnWrite);
+  writable.mutableData()[1] = 20;
+  writable.save(copyPath.c_str());
+
+  mrt::MappedArray<int> original(path.c_str());
+  mrt::MappedArray<int> saved(copyPath.c_str());
+  bool ok = writable[1] == 20 && original[1] == 2 && saved == mrt::Array<int>{1, 20, 3};
+  std::remove(path.c_str());
+  std::remove(copyPath.c_str());
+
+  return ok;
+}
+
+bool test_read_only() {
+  std::string path = tempPath("read_only");
+  mrt::Array<int> arr = {1, 2, 3};
+  arr.save(path.c_str());
+
+  mrt::MappedArray<int> mapped(path.c_str());
+  bool thrown = false;
+  try {
+    mapped.mutableData();
+  } catch (mrt::MappedFileException& e) {
+    thrown = true;
+  }
+  std::remove(path.c_str());
+
+  return thrown;
+}
+
+bool test_invalid() {
+  std::string path = tempPath("invalid");
+  mrt::Array<uint32_t> arr = {1, 2, 3};
+  arr.save(path.c_str());
+
+  int thrown = 0;
+  try {
+    mrt::MappedArray<uint64_t> mapped(path.c_str());
+  } catch (mrt::MappedFileException& e) {
+    thrown++;
+  }
+  try {
+    mrt::MappedArray<uint32_t> mapped(tempPath("missing").c_str());
+  } catch (mrt::MappedFileException& e) {
+    thrown++;
+  }
+  std::remove(path.c_str());
+
+  return thrown == 2;
+}
+
+bool test_move() {
+  std::string path = tempPath("move");
+  mrt::Array<int> arr = {1, 2, 3};
+  arr.save(path.c_str());
+
+  mrt::MappedArray<int> mapped(path.c_str());
+  mrt::MappedArray<int> moved = std::move(mapped);
+  mrt::MappedArray<int> assigned;
+  assigned = std::move(moved);
+  bool ok = mapped.size() == 0 && moved.size() == 0 && assigned == arr;
+  std::remove(path.c_str());
+
+  return ok;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("mapped_array");
+
+  framework.addTests({
+    {"test_roundtrip", test_roundtrip},
+    {"test_structs", test_structs},
+    {"test_search", test_search},
+    {"test_empty", test_empty},
+    {"test_copy_on_write", test_copy_on_write},
+    {"test_read_only", test_read_only},
+    {"test_invalid", test_invalid},
+    {"test_move", test_move},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,118 @@
+#include "test.h"
+#include <mrt/sort/parallel_merge.h>
+#include <mrt/thread_pool.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+struct Record {
+  uint32_t key;
+  uint32_t order;
+};
+
+mrt::Array<Record> records(size_t count, uint32_t keys) {
+  mrt::Array<Record> arr;
+  for (uint32_t i = 0; i < count; i++) {
+    arr.append(Record{(uint32_t) (i * 2654435761u) % keys, i});
+  }
+  return arr;
+}
+
+// Ordered by key, equal keys keep their original order
+bool sortedStably(const mrt::Array<Record>& arr) {
+  for (size_t i = 1; i < arr.size(); i++) {
+    if (arr[i].key < arr[i-1].key) return false;
+    if (arr[i].key == arr[i-1].key && arr[i].order < arr[i-1].order) return false;
+  }
+  return true;
+}
+
+bool test_sort() {
+  mrt::ThreadPool pool(4);
+  mrt::Array<int> arr = {1, 10, 1941, 13, 3, -6, 14};
+
+  arr.sort(mrt::Ascending<int>(), mrt::ParallelMergeSort(4, 2, pool));
+
+  return arr == mrt::Array<int>{-6, 1, 3, 10, 13, 14, 1941};
+}
+
+bool test_stable() {
+  mrt::ThreadPool pool(4);
+  auto byKey = [](Record& lhs, Record& rhs) { return lhs.key < rhs.key; };
+
+  // Chunk counts that don't divide the size, odd runs left over between merge rounds
+  for (size_t threads : {1, 2, 3, 4, 7}) {
+    mrt::Array<Record> arr = records(100000, 100);
+    mrt::ParallelMergeSort(threads, 1000, pool).sort(byKey, arr);
+    if (!sortedStably(arr) || arr.size() != 100000) return false;
+  }
+  return true;
+}
+
+bool test_sizes() {
+  mrt::ThreadPool pool(4);
+  mrt::ParallelMergeSort sorter(4, 1, pool);
+
+  for (size_t size = 0; size < 300; size++) {
+    mrt::Array<Record> arr = records(size, 7);
+    sorter.sort([](Record& lhs, Record& rhs) { return lhs.key < rhs.key; }, arr);
+    if (!sortedStably(arr)) return false;
+  }
+  return true;
+}
+
+bool test_comparator() {
+  mrt::ThreadPool pool(3);
+  mrt::Array<uint32_t> arr;
+  for (uint32_t i = 0; i < 50000; i++) {
+    arr.append(i * 2654435761u);
+  }
+  std::vector<uint32_t> expected(arr.data(), arr.data() + arr.size());
+  std::sort(expected.begin(), expected.end(), [](uint32_t lhs, uint32_t rhs) { return lhs > rhs; });
+
+  arr.sort(mrt::Descending<uint32_t>(), mrt::ParallelMergeSort(0, 100, pool));
+
+  return std::equal(expected.begin(), expected.end(), arr.data());
+}
+
+bool test_non_trivial() {
+  mrt::ThreadPool pool(4);
+  mrt::Array<std::string> arr;
+  for (int i = 0; i < 5000; i++) {
+    arr.append(std::to_string((i * 7919) % 5000));
+  }
+
+  auto sorted = arr.sorted(mrt::Ascending<std::string>(), mrt::ParallelMergeSort(4, 100, pool));
+
+  for (size_t i = 1; i < sorted.size(); i++) {
+    if (sorted[i] < sorted[i-1]) return false;
+  }
+  return sorted.size() == 5000 && sorted.contains("4999");
+}
+
+bool test_list() {
+  mrt::ThreadPool pool(2);
+  mrt::List<int> list = {4, -2, 9, 0, 4};
+
+  mrt::ParallelMergeSort(2, 1, pool).sort(mrt::Ascending<int>(), list);
+
+  return list == mrt::List<int>{-2, 0, 4, 4, 9};
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("parallel_merge_sort");
+
+  framework.addTests({
+    {"test_sort", test_sort},
+    {"test_stable", test_stable},
+    {"test_sizes", test_sizes},
+    {"test_comparator", test_comparator},
+    {"test_non_trivial", test_non_trivial},
+    {"test_list", test_list},
+  });
+
+  return framework.run(argc, argv);
+}
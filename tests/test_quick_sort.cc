@@ -0,0 +1,135 @@
+#include "test.h"
+#include <mrt/sort/quick.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+template <typename T, typename F = mrt::Ascending<T>>
+bool sortsLike(mrt::Array<T> arr, F comparator = {}) {
+  std::vector<T> expected(arr.data(), arr.data() + arr.size());
+  std::sort(expected.begin(), expected.end(), comparator);
+
+  arr.sort(comparator, mrt::QuickSort());
+
+  return std::equal(expected.begin(), expected.end(), arr.data());
+}
+
+// Inputs that trouble simple quicksorts: sorted, reversed, organ pipe, all equal, few distinct keys
+mrt::Array<int> pattern(size_t size, int kind) {
+  mrt::Array<int> arr;
+  for (size_t i = 0; i < size; i++) {
+    switch (kind) {
+      case 0: arr.append((int) (i * 2654435761u)); break;
+      case 1: arr.append((int) i); break;
+      case 2: arr.append((int) (size - i)); break;
+      case 3: arr.append((int) (i < size / 2 ? i : size - i)); break;
+      case 4: arr.append(7); break;
+      default: arr.append((int) ((i * 2654435761u) % 4)); break;
+    }
+  }
+  return arr;
+}
+
+bool test_sort() {
+  mrt::Array<int> arr = {1, 10, 1941, 13, 3, -6, 14};
+
+  arr.sort<mrt::QuickSort>();
+
+  return arr == mrt::Array<int>{-6, 1, 3, 10, 13, 14, 1941};
+}
+
+bool test_patterns() {
+  for (size_t size : {0, 1, 2, 23, 24, 25, 100, 1000, 100000}) {
+    for (int kind = 0; kind < 6; kind++) {
+      if (!sortsLike(pattern(size, kind))) return false;
+      if (!sortsLike(pattern(size, kind), mrt::Descending<int>())) return false;
+    }
+  }
+  return true;
+}
+
+bool test_floating() {
+  mrt::Array<double> arr;
+  for (uint32_t i = 0; i < 10000; i++) {
+    arr.append((double) (int32_t) (i * 2654435761u) / 7.0);
+  }
+  return sortsLike(arr);
+}
+
+bool test_non_arithmetic() {
+  mrt::Array<std::string> arr;
+  for (int i = 0; i < 5000; i++) {
+    arr.append(std::to_string((i * 7919) % 1000));
+  }
+  return sortsLike(arr);
+}
+
+/*
+  M. D. McIlroy, "A killer adversary for quicksort": values are decided while sorting, always
+  against the current pivot candidate. Quicksort without a fallback does O(n^2) comparisons.
+*/
+struct Adversary {
+  std::vector<int> values;
+  int gas;
+  int solid = 0;
+  int candidate = 0;
+  size_t comparisons = 0;
+
+  Adversary(size_t size) : values(size, (int) size), gas((int) size) {}
+
+  bool operator()(int& lhs, int& rhs) {
+    comparisons++;
+    if (values[lhs] == gas && values[rhs] == gas) {
+      values[lhs == candidate ? lhs : rhs] = solid++;
+    }
+    if (values[lhs] == gas) {
+      candidate = lhs;
+    } else if (values[rhs] == gas) {
+      candidate = rhs;
+    }
+    return values[lhs] < values[rhs];
+  }
+};
+
+bool test_adversarial() {
+  constexpr size_t SIZE = 1 << 14;
+  mrt::Array<int> arr;
+  for (int i = 0; i < (int) SIZE; i++) {
+    arr.append(i);
+  }
+
+  Adversary adversary(SIZE);
+  mrt::QuickSort().sort([&adversary](int& lhs, int& rhs) { return adversary(lhs, rhs); }, arr);
+
+  for (size_t i = 1; i < SIZE; i++) {
+    if (adversary.values[arr[i]] < adversary.values[arr[i-1]]) return false;
+  }
+  // Heapsort fallback keeps it near n log n, 14 * SIZE here
+  return adversary.comparisons < 6 * 14 * SIZE;
+}
+
+bool test_list() {
+  mrt::List<int> list = {4, -2, 9, 0, 4};
+
+  mrt::QuickSort().sort(mrt::Ascending<int>(), list);
+
+  return list == mrt::List<int>{-2, 0, 4, 4, 9};
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("quick_sort");
+
+  framework.addTests({
+    {"test_sort", test_sort},
+    {"test_patterns", test_patterns},
+    {"test_floating", test_floating},
+    {"test_non_arithmetic", test_non_arithmetic},
+    {"test_adversarial", test_adversarial},
+    {"test_list", test_list},
+  });
+
+  return framework.run(argc, argv);
+}
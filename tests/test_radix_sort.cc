@@ -0,0 +1,160 @@
+#include "test.h"
+#include <mrt/sort/radix.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <mrt/string.h>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+template <typename T>
+bool sortsLike(mrt::Array<T> arr) {
+  std::vector<T> expected(arr.data(), arr.data() + arr.size());
+  std::sort(expected.begin(), expected.end());
+
+  arr.template sort<mrt::RadixSort>();
+
+  for (size_t i = 0; i < arr.size(); i++) {
+    if (!(arr[i] == expected[i])) return false;
+  }
+  return true;
+}
+
+bool test_unsigned() {
+  mrt::Array<uint32_t> arr;
+  for (uint32_t i = 0; i < 10000; i++) {
+    arr.append(i * 2654435761u);
+  }
+  return sortsLike(arr) && sortsLike(mrt::Array<uint8_t>{3, 255, 0, 7, 7, 128});
+}
+
+bool test_signed() {
+  mrt::Array<int64_t> arr = {5, -3, 0, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max(), -1, 1};
+  mrt::Array<int16_t> shorts;
+  for (int i = 0; i < 1000; i++) {
+    shorts.append((int16_t) (i * 7919));
+  }
+  return sortsLike(arr) && sortsLike(shorts);
+}
+
+bool test_floating() {
+  mrt::Array<double> arr = {1.5, -0.25, 0.0, -1e300, 1e-300, -7.0, 3.25, std::numeric_limits<double>::infinity()};
+  mrt::Array<float> floats = {2.5f, -2.5f, 0.5f, -0.0f, 100.0f, -100.0f};
+  return sortsLike(arr) && sortsLike(floats);
+}
+
+bool test_descending() {
+  mrt::Array<int> arr = {1, 10, 1941, 13, 3, -6, 14};
+
+  arr.sort<mrt::RadixSort>(mrt::Descending<int>());
+
+  return arr == mrt::Array<int>{1941, 14, 13, 10, 3, 1, -6};
+}
+
+bool test_skipped_passes() {
+  // Only the low byte differs, and keys that are all equal
+  mrt::Array<uint64_t> arr = {0xAB00000000000003, 0xAB00000000000001, 0xAB00000000000002};
+  mrt::Array<int> same = mrt::Array<int>::filled(100, 42);
+
+  return sortsLike(arr) && sortsLike(same) && sortsLike(mrt::Array<int>{}) && sortsLike(mrt::Array<int>{1});
+}
+
+struct Record {
+  uint32_t id;
+  int order;
+
+  bool operator==(const Record&) const = default;
+};
+
+bool test_key() {
+  mrt::Array<Record> arr;
+  for (int i = 0; i < 1000; i++) {
+    arr.append(Record{(uint32_t) (i * 7) % 10, i});
+  }
+
+  mrt::RadixSort().sort([](const Record& record) { return record.id; }, arr);
+
+  // Stable: equal ids keep their original order
+  for (size_t i = 1; i < arr.size(); i++) {
+    if (arr[i].id < arr[i-1].id) return false;
+    if (arr[i].id == arr[i-1].id && arr[i].order < arr[i-1].order) return false;
+  }
+  return true;
+}
+
+bool test_key_non_trivial() {
+  mrt::Array<mrt::String> arr = {"ccc", "a", "bbbb", "dd"};
+
+  mrt::RadixSort().sort([](const mrt::String& s) { return s.size(); }, arr);
+
+  return arr == mrt::Array<mrt::String>{"a", "dd", "ccc", "bbbb"};
+}
+
+bool test_list() {
+  mrt::List<int> list = {4, -2, 9, 0};
+
+  mrt::RadixSort().sort(mrt::Ascending<int>(), list);
+
+  return list == mrt::List<int>{-2, 0, 4, 9};
+}
+
+bool test_fallback() {
+  // Comparators other than Ascending and Descending go to MergeSort
+  mrt::Array<int> arr = {1, 10, 1941, 13, 3, -6, 14};
+
+  arr.sort<mrt::RadixSort>([](int& lhs, int& rhs) { return lhs % 10 < rhs % 10; });
+
+  for (size_t i = 1; i < arr.size(); i++) {
+    if (arr[i] % 10 < arr[i-1] % 10) return false;
+  }
+  return arr.size() == 7;
+}
+
+struct Moved {
+  int key;
+  static inline size_t moves = 0;
+
+  Moved(int key) : key(key) {}
+  Moved(Moved&& rhs) : key(rhs.key) { moves++; }
+  Moved& operator=(Moved&& rhs) {
+    key = rhs.key;
+    moves++;
+    return *this;
+  }
+};
+
+bool test_moves_in_place() {
+  mrt::Array<Moved> arr = mrt::Array<Moved>::empty(8);
+  for (int key : {5, 0, 1, 2, 3, 4, 7, 6}) {
+    arr.append(Moved(key));
+  }
+  Moved::moves = 0;
+
+  mrt::RadixSort().sort([](const Moved& value) { return value.key; }, arr);
+
+  // A cycle of 6 and one of 2: one move per displaced element, plus one per cycle
+  for (int i = 0; i < 8; i++) {
+    if (arr[i].key != i) return false;
+  }
+  return Moved::moves == 10;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("radix_sort");
+
+  framework.addTests({
+    {"test_unsigned", test_unsigned},
+    {"test_signed", test_signed},
+    {"test_floating", test_floating},
+    {"test_descending", test_descending},
+    {"test_skipped_passes", test_skipped_passes},
+    {"test_key", test_key},
+    {"test_key_non_trivial", test_key_non_trivial},
+    {"test_list", test_list},
+    {"test_fallback", test_fallback},
+    {"test_moves_in_place", test_moves_in_place},
+  });
+
+  return framework.run(argc, argv);
+}
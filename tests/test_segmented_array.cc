@@ -0,0 +1,137 @@
+#include "test.h"
+#include <mrt/segmented_array.h>
+#include <mrt/array.h>
+#include <string>
+#include <cstdio>
+
+bool test_append_index() {
+  mrt::SegmentedArray<int> arr;
+
+  for (int i = 0; i < 1000; i++) {
+    arr.append(i);
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    if (arr[i] != i) return false;
+  }
+
+  return arr.size() == 1000 && arr.capacity() >= 1000 && arr.get(1000, -1) == -1;
+}
+
+bool test_stable_addresses() {
+  mrt::SegmentedArray<std::string> arr;
+  arr.append("first");
+  std::string* first = &arr[0];
+  const char* chars = arr[0].data();
+
+  mrt::Array<std::string*> pointers;
+  for (int i = 0; i < 5000; i++) {
+    pointers.append(&arr.emplace(std::to_string(i)));
+  }
+
+  for (int i = 0; i < 5000; i++) {
+    if (pointers[i] != &arr[i + 1] || *pointers[i] != std::to_string(i)) return false;
+  }
+
+  return first == &arr[0] && chars == arr[0].data() && *first == "first";
+}
+
+bool test_segments() {
+  mrt::SegmentedArray<int> arr;
+  size_t total = 0;
+
+  for (int i = 0; i < 100; i++) {
+    arr.append(i);
+  }
+
+  // 16 + 32 + 52 of 64
+  for (size_t k = 0; k < arr.segments(); k++) {
+    auto segment = arr.segment(k);
+    if (segment[0] != (int) total) return false;
+    total += segment.size();
+  }
+
+  return arr.segments() == 3 && arr.segment(2).size() == 52 && total == 100;
+}
+
+bool test_pop() {
+  mrt::SegmentedArray<std::string> arr = {"a", "b", "c"};
+
+  std::string last = arr.pop();
+  arr.append("d");
+
+  return last == "c" && arr.size() == 3 && arr[2] == "d" && arr.pop() == "d" && arr.pop() == "b";
+}
+
+bool test_iterate() {
+  mrt::SegmentedArray<int> arr;
+  for (int i = 0; i < 200; i++) {
+    arr.append(i);
+  }
+
+  int expected = 0;
+  for (int& x : arr) {
+    if (x != expected++) return false;
+    x *= 2;
+  }
+
+  return expected == 200 && arr[199] == 398;
+}
+
+bool test_find() {
+  mrt::SegmentedArray<int> arr;
+  for (int i = 0; i < 300; i++) {
+    arr.append(i % 100);
+  }
+
+  auto indexes = arr.find(42);
+
+  return arr.contains(99) && !arr.contains(100) && arr.lfind(42) == 42 && arr.lfind(42, 43) == 142
+    && arr.rfind(42) == 242 && arr.rfind(42, 241) == 142 && arr.rfind(0, 5) == 0
+    && indexes == mrt::Array<size_t>{42, 142, 242};
+}
+
+bool test_functional() {
+  mrt::SegmentedArray<int> arr;
+  for (int i = 1; i <= 100; i++) {
+    arr.append(i);
+  }
+
+  auto even = arr.filter([](const int& x) { return x % 2 == 0; });
+  auto strings = arr.map<std::string>([](const int& x) { return std::to_string(x); });
+  int sum = 0;
+  arr.foreach([&sum](const int& x) { sum += x; });
+
+  return sum == 5050 && arr.reduce([](int acc, const int& x) { return acc + x; }) == 5050
+    && even.size() == 50 && even[49] == 100 && strings[99] == "100"
+    && arr.view().filter([](const int& x) { return x > 90; }).count() == 10;
+}
+
+bool test_copy_move() {
+  mrt::SegmentedArray<std::string> arr = {"a", "b", "c"};
+  mrt::SegmentedArray<std::string> copy = arr;
+  std::string* element = &arr[1];
+
+  mrt::SegmentedArray<std::string> moved = std::move(arr);
+  copy[0] = "x";
+
+  return moved.size() == 3 && &moved[1] == element && arr.size() == 0 && copy != moved
+    && copy[0] == "x" && moved[0] == "a";
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("segmented_array");
+
+  framework.addTests({
+    {"test_append_index", test_append_index},
+    {"test_stable_addresses", test_stable_addresses},
+    {"test_segments", test_segments},
+    {"test_pop", test_pop},
+    {"test_iterate", test_iterate},
+    {"test_find", test_find},
+    {"test_functional", test_functional},
+    {"test_copy_move", test_copy_move},
+  });
+
+  return framework.run(argc, argv);
+}
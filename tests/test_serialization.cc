@@ -0,0 +1,206 @@
+#include "test.h"
+#include <mrt/serialization.h>
+#include <mrt/string.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <mrt/map.h>
+#include <mrt/pair.h>
+#include <cstdint>
+#include <cstdio>
+#include <unistd.h>
+
+struct Point {
+  int32_t x;
+  int32_t y;
+
+  bool operator==(const Point& rhs) const { return x == rhs.x && y == rhs.y; }
+};
+
+enum class Color : uint8_t {
+  Red, Green, Blue,
+};
+
+bool test_scalars() {
+  mrt::BinaryWriter writer;
+  writer.write(42).write(-1.5).write(Color::Blue).write(Point{3, -4}).write(true);
+
+  mrt::BinaryReader reader(writer.buffer());
+  return reader.read<int>() == 42 && reader.read<double>() == -1.5 && reader.read<Color>() == Color::Blue
+    && reader.read<Point>() == Point{3, -4} && reader.read<bool>() && reader.atEnd();
+}
+
+bool test_sizes() {
+  mrt::BinaryWriter writer;
+  uint64_t sizes[] = {0, 1, 127, 128, 300, 1ull << 35, ~0ull};
+  for (uint64_t size : sizes) {
+    writer.writeSize(size);
+  }
+
+  mrt::BinaryReader reader(writer.buffer());
+  for (uint64_t size : sizes) {
+    if (reader.readSize() != size) return false;
+  }
+  // Header, then 1 + 1 + 1 + 2 + 2 + 6 + 10 bytes
+  return reader.atEnd() && writer.buffer().size() == mrt::serialization::HEADER_SIZE + 23;
+}
+
+bool test_array() {
+  mrt::Array<uint64_t> numbers;
+  for (uint64_t i = 0; i < 100000; i++) {
+    numbers.append(i * i);
+  }
+  mrt::Array<Point> points = {{1, 2}, {3, 4}};
+  mrt::Array<int> empty;
+
+  mrt::BinaryWriter writer;
+  writer.write(numbers).write(points).write(empty);
+
+  mrt::BinaryReader reader(writer.buffer());
+  return reader.read<mrt::Array<uint64_t>>() == numbers && reader.read<mrt::Array<Point>>() == points
+    && reader.read<mrt::Array<int>>().size() == 0 && reader.atEnd();
+}
+
+bool test_string() {
+  mrt::String s = "hello, world";
+  mrt::String empty;
+
+  mrt::BinaryWriter writer;
+  writer.write(s).write(empty);
+
+  mrt::BinaryReader reader(writer.buffer());
+  mrt::String decoded = reader.read<mrt::String>();
+  mrt::String decodedEmpty = reader.read<mrt::String>();
+  return decoded == s && decoded.c_str()[decoded.size()] == 0 && decodedEmpty.size() == 0
+    && decodedEmpty.c_str()[0] == 0;
+}
+
+bool test_nested() {
+  mrt::List<mrt::String> list = {"a", "bc", "def"};
+  mrt::Map<mrt::String, mrt::Array<int>> map = {{"one", {1}}, {"two", {2, 2}}, {"none", {}}};
+  mrt::Array<mrt::Pair<mrt::String, int>> pairs = {{"x", 1}, {"y", 2}};
+
+  mrt::BinaryWriter writer;
+  writer.write(list).write(map).write(pairs);
+
+  mrt::BinaryReader reader(writer.buffer());
+  auto decodedList = reader.read<mrt::List<mrt::String>>();
+  auto decodedMap = reader.read<mrt::Map<mrt::String, mrt::Array<int>>>();
+  auto decodedPairs = reader.read<mrt::Array<mrt::Pair<mrt::String, int>>>();
+
+  return decodedList == list && decodedMap.size() == 3 && decodedMap["two"] == mrt::Array<int>{2, 2}
+    && decodedMap["none"].size() == 0 && decodedPairs.size() == 2 && decodedPairs[1]._1 == "y"
+    && decodedPairs[1]._2 == 2 && reader.atEnd();
+}
+
+bool test_decode_replaces() {
+  mrt::Array<int> arr = {1, 2, 3};
+  mrt::List<int> list = {4, 5};
+
+  mrt::BinaryWriter writer;
+  writer.write(mrt::Array<int>{7}).write(mrt::List<int>{8});
+
+  mrt::BinaryReader reader(writer.buffer());
+  reader.read(arr).read(list);
+
+  return arr == mrt::Array<int>{7} && list.size() == 1 && list[0] == 8;
+}
+
+bool test_fd() {
+  int fds[2];
+  if (pipe(fds) != 0) return false;
+
+  mrt::Array<uint32_t> large;
+  for (uint32_t i = 0; i < 50000; i++) {
+    large.append(i);
+  }
+
+  // Smaller than the pipe buffer, so the writer doesn't block before the reader starts
+  {
+    mrt::BinaryWriter writer(fds[1]);
+    writer.write(mrt::String("header")).write(large.slice(0, 10000)).write(7);
+  }
+  close(fds[1]);
+
+  mrt::BinaryReader reader(fds[0]);
+  bool ok = reader.read<mrt::String>() == "header" && reader.read<mrt::Array<uint32_t>>() == large.slice(0, 10000)
+    && reader.read<int>() == 7 && reader.atEnd();
+  close(fds[0]);
+
+  return ok;
+}
+
+bool test_file() {
+  std::string path = "/tmp/mrt_serialization_" + std::to_string(getpid());
+  mrt::Array<uint32_t> large;
+  for (uint32_t i = 0; i < 300000; i++) {
+    large.append(i * 3);
+  }
+
+  FILE* out = fopen(path.c_str(), "wb");
+  {
+    mrt::BinaryWriter writer(fileno(out));
+    for (int i = 0; i < 3; i++) {
+      writer.write(large).write(i);
+    }
+    writer.flush();
+  }
+  fclose(out);
+
+  FILE* in = fopen(path.c_str(), "rb");
+  mrt::BinaryReader reader(fileno(in));
+  bool ok = true;
+  for (int i = 0; i < 3; i++) {
+    ok = ok && reader.read<mrt::Array<uint32_t>>() == large && reader.read<int>() == i;
+  }
+  ok = ok && reader.atEnd();
+  fclose(in);
+  std::remove(path.c_str());
+
+  return ok;
+}
+
+bool test_truncated() {
+  mrt::BinaryWriter writer;
+  writer.write(mrt::Array<int>{1, 2, 3});
+
+  int thrown = 0;
+  try {
+    mrt::BinaryReader reader(writer.buffer().data(), writer.buffer().size() - 1);
+    reader.read<mrt::Array<int>>();
+  } catch (mrt::SerializationException& e) {
+    thrown++;
+  }
+  try {
+    uint8_t garbage[16] = {'n', 'o', 'p', 'e'};
+    mrt::BinaryReader reader(garbage, sizeof(garbage));
+  } catch (mrt::SerializationException& e) {
+    thrown++;
+  }
+  try {
+    uint8_t huge[] = {'M', 'R', 'T', 'S', 1, mrt::serialization::byteOrder(), 0, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+    mrt::BinaryReader reader(huge, sizeof(huge));
+    reader.read<mrt::Array<mrt::String>>();
+  } catch (mrt::SerializationException& e) {
+    thrown++;
+  }
+
+  return thrown == 3;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("serialization");
+
+  framework.addTests({
+    {"test_scalars", test_scalars},
+    {"test_sizes", test_sizes},
+    {"test_array", test_array},
+    {"test_string", test_string},
+    {"test_nested", test_nested},
+    {"test_decode_replaces", test_decode_replaces},
+    {"test_fd", test_fd},
+    {"test_file", test_file},
+    {"test_truncated", test_truncated},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,213 @@
+#include "test.h"
+#include <mrt/small_array.h>
+#include <type_traits>
+#include <string>
+#include <cstdio>
+
+bool test_copy() {
+  mrt::SmallArray<int, 4> arr = {0, 1, 2, 3, 4};
+  mrt::SmallArray<int, 4> arr2 = arr;
+
+  return arr2 == arr;
+}
+
+bool test_inline() {
+  mrt::SmallArray<int, 4> arr;
+
+  for (int i = 0; i < 4; i++) {
+    arr.append(i);
+  }
+
+  return arr.isInline() && arr.size() == 4;
+}
+
+bool test_spill() {
+  mrt::SmallArray<int, 4> arr;
+  mrt::Array<int> expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  for (int i = 0; i < 10; i++) {
+    arr.append(i);
+  }
+
+  return !arr.isInline() && arr == expected;
+}
+
+bool test_clear() {
+  mrt::SmallArray<int, 4> arr = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  arr.clear();
+  arr.append(1);
+
+  return arr.isInline() && arr.size() == 1 && arr[0] == 1;
+}
+
+bool test_move() {
+  mrt::SmallArray<std::string, 2> arr = {"a", "b"};
+  mrt::SmallArray<std::string, 2> spilled = {"a", "b", "c"};
+
+  mrt::SmallArray<std::string, 2> arr2 = std::move(arr);
+  mrt::SmallArray<std::string, 2> spilled2 = std::move(spilled);
+
+  return arr2.isInline() && arr2.size() == 2 && arr2[1] == "b" && arr.size() == 0
+      && spilled2.size() == 3 && spilled2[2] == "c" && spilled.size() == 0;
+}
+
+bool test_move_to_array() {
+  mrt::SmallArray<std::string, 4> arr = {"a", "b"};
+
+  mrt::Array<std::string> arr2 = std::move(arr);
+  arr2.append("c");
+
+  return arr2.size() == 3 && arr2[0] == "a" && arr2[2] == "c";
+}
+
+bool test_insert_remove() {
+  mrt::SmallArray<int, 4> arr = {0, 1, 4};
+  mrt::Array<int> expected = {1, 2, 3, 4};
+
+  arr.insert(2, 2);
+  arr.insert(3, 3);
+  arr.remove(0);
+
+  return arr == expected;
+}
+
+bool test_slice() {
+  mrt::SmallArray<int, 4> arr = {0, 1, 2, 3, 4, 5};
+  mrt::Array<int> expected = {2, 3, 4};
+
+  return arr.slice(2, 5) == expected;
+}
+
+bool test_sort() {
+  mrt::SmallArray<int, 4> arr = {1, 10, 1941, 13, 3, -6, 14};
+  mrt::Array<int> expected = {-6, 1, 3, 10, 13, 14, 1941};
+
+  auto sorted = arr.sorted();
+  arr.sort(mrt::asc<int>);
+
+  return arr == expected && sorted == expected;
+}
+
+bool test_filter() {
+  mrt::SmallArray<int, 4> arr = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  mrt::Array<int> expected = {5, 6, 7};
+
+  auto result = arr.filter([](auto x) { return x > 4 && x < 8; });
+
+  return result.isInline() && result == expected;
+}
+
+bool test_reduce() {
+  mrt::SmallArray<int, 4> arr = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  return arr.reduce<int>([](int s, auto x) { return s + x; }) == 45;
+}
+
+bool test_map() {
+  mrt::SmallArray<int, 4> arr = {1, 2, 3};
+  mrt::Array<std::string> expected = {"1", "2", "3"};
+
+  auto result = arr.map<std::string>([](auto x) { return std::to_string(x); });
+
+  return result.isInline() && result == expected;
+}
+
+bool test_and() {
+  mrt::SmallArray<int, 4> arr = {10, 1, 2, 3, 4};
+  mrt::SmallArray<int, 4> arr2 = {15, 3, 1, 5, 2};
+  mrt::Array<int> expected = {1, 2, 3};
+
+  return (arr & arr2) == expected;
+}
+
+bool test_or() {
+  mrt::SmallArray<int, 4> arr = {10, 1, 2, 3, 4};
+  mrt::SmallArray<int, 4> arr2 = {15, 3, 1, 5, 2};
+  mrt::Array<int> expected = {10, 4};
+
+  return (arr | arr2) == expected;
+}
+
+bool test_memory_stats() {
+  mrt::SmallArray<int, 4> arr = {1, 2};
+  size_t inlineUsage = arr.memoryUsage();
+
+  for (int i = 0; i < 10; i++) {
+    arr.append(i);
+  }
+
+  return inlineUsage == 0 && arr.memoryUsage() == arr.capacity() * sizeof(int) && arr.stats().live == 12 * sizeof(int);
+}
+
+bool test_unique_large() {
+  // Goes through the hash path of Array, the quadratic loop would take minutes here
+  mrt::SmallArray<int, 4> arr;
+  mrt::Array<int> plain;
+  for (int i = 0; i < 200000; i++) {
+    arr.append((i * 7919) % 50000);
+    plain.append((i * 7919) % 50000);
+  }
+  auto unique = arr.unique();
+
+  mrt::SmallArray<int, 4> small = {3, 1, 3, 1};
+  auto smallUnique = small.unique();
+
+  return unique.size() == 50000 && unique == plain.unique() && (arr & unique).size() == arr.size()
+    && smallUnique.isInline() && smallUnique == mrt::Array<int>{3, 1};
+}
+
+bool test_clear_through_array() {
+  mrt::SmallArray<int, 4> arr = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  mrt::Array<int>& base = arr;
+
+  // Clearing through the base goes back to inline storage, like clear() on SmallArray
+  base.clear();
+  bool cleared = arr.isInline() && arr.size() == 0 && arr.memoryUsage() == 0;
+  base.append(1);
+  base.append(2);
+
+  // Moved-from arrays go back to inline storage too
+  mrt::SmallArray<int, 4> moved = std::move(arr);
+  arr.append(3);
+
+  return cleared && moved == mrt::Array<int>{1, 2} && moved.isInline() && arr.isInline() && arr[0] == 3;
+}
+
+// Moving inline elements into a plain Array allocates, so only SmallArray moves are noexcept
+static_assert(std::is_nothrow_move_constructible_v<mrt::SmallArray<int, 4>>);
+static_assert(!std::is_nothrow_move_constructible_v<mrt::Array<int>>);
+
+bool test_move_into_array() {
+  mrt::SmallArray<std::string, 4> arr = {"a", "b"};
+  mrt::Array<std::string> moved = std::move(arr);
+
+  return moved == mrt::Array<std::string>{"a", "b"} && moved.memoryUsage() > 0 && arr.size() == 0 && arr.isInline();
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("small_array");
+
+  framework.addTests({
+    {"test_copy", test_copy},
+    {"test_inline", test_inline},
+    {"test_spill", test_spill},
+    {"test_clear", test_clear},
+    {"test_move", test_move},
+    {"test_move_to_array", test_move_to_array},
+    {"test_insert_remove", test_insert_remove},
+    {"test_slice", test_slice},
+    {"test_sort", test_sort},
+    {"test_filter", test_filter},
+    {"test_reduce", test_reduce},
+    {"test_map", test_map},
+    {"test_and", test_and},
+    {"test_or", test_or},
+    {"test_memory_stats", test_memory_stats},
+    {"test_unique_large", test_unique_large},
+    {"test_clear_through_array", test_clear_through_array},
+    {"test_move_into_array", test_move_into_array},
+  });
+
+  return framework.run(argc, argv);
+}
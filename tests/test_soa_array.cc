@@ -0,0 +1,160 @@
+#include "test.h"
+#include <mrt/soa_array.h>
+#include <mrt/array.h>
+#include <string>
+#include <tuple>
+#include <cstdio>
+
+using Records = mrt::SoAArray<int, double, std::string>;
+
+Records records() {
+  Records result;
+  result.append(3, 0.5, "c");
+  result.append(1, 1.5, "a");
+  result.append(2, 2.5, "b");
+  result.append(0, 3.5, "z");
+  return result;
+}
+
+bool test_append() {
+  Records arr = records();
+  arr.emplace(7, 1.0, "seven");
+  arr.append(std::make_tuple(8, 2.0, std::string("eight")));
+
+  return arr.size() == 6 && arr.get<0>(4) == 7 && arr.get<2>(4) == "seven"
+    && arr.row(5) == std::make_tuple(8, 2.0, std::string("eight"));
+}
+
+bool test_columns() {
+  Records arr = records();
+  auto ids = arr.column<0>();
+  auto scores = arr.column<1>();
+
+  double* data = arr.data<1>();
+  for (size_t i = 0; i < arr.size(); i++) {
+    data[i] *= 2;
+  }
+
+  return ids.size() == 4 && ids[1] == 1 && scores[3] == 7.0
+    && arr.column<1>().reduce<double>([](double s, const double& x) { return s + x; }) == 16.0;
+}
+
+bool test_rows() {
+  Records arr = records();
+
+  arr[1].get<2>() = "A";
+  arr[2] = std::make_tuple(20, 20.5, std::string("B"));
+  std::tuple<int, double, std::string> row = arr[2];
+
+  const Records& constArr = arr;
+  return constArr[1].get<2>() == "A" && std::get<0>(row) == 20 && constArr[2].get<1>() == 20.5;
+}
+
+bool test_iterate() {
+  Records arr = records();
+  int sum = 0;
+
+  for (auto row : arr) {
+    sum += row.get<0>();
+    row.get<1>() = 0;
+  }
+
+  return sum == 6 && arr.column<1>().reduce<double>([](double s, const double& x) { return s + x; }) == 0;
+}
+
+bool test_foreach_reduce() {
+  Records arr = records();
+  std::string names;
+
+  arr.foreach([&names](const int&, const double&, const std::string& name) { names += name; });
+  double weighted = arr.reduce([](double acc, const int& id, const double& score, const std::string&) {
+    return acc + id * score;
+  }, 0.0);
+
+  return names == "cabz" && weighted == 3 * 0.5 + 1 * 1.5 + 2 * 2.5;
+}
+
+bool test_filter() {
+  Records arr = records();
+  auto filtered = arr.filter([](const int& id, const double& score, const std::string&) { return id > 0 && score > 1; });
+
+  return filtered.size() == 2 && filtered.row(0) == std::make_tuple(1, 1.5, std::string("a"))
+    && filtered.row(1) == std::make_tuple(2, 2.5, std::string("b"));
+}
+
+bool test_sort() {
+  Records arr = records();
+  arr.sortBy<0>();
+
+  Records byName = records();
+  byName.sortBy<2>(mrt::Descending<std::string>());
+
+  mrt::Array<int> ids(arr.column<0>());
+  mrt::Array<int> nameIds(byName.column<0>());
+  return ids == mrt::Array<int>{0, 1, 2, 3} && arr.get<2>(0) == "z" && arr.get<1>(3) == 0.5
+    && nameIds == mrt::Array<int>{0, 3, 2, 1};
+}
+
+bool test_sort_large() {
+  mrt::SoAArray<unsigned, unsigned> arr;
+  for (unsigned i = 0; i < 1000; i++) {
+    unsigned key = (i * 7919) % 1000;
+    arr.append(key, key * 2);
+  }
+  arr.sortBy<0>();
+
+  for (unsigned i = 0; i < 1000; i++) {
+    if (arr.get<0>(i) != i || arr.get<1>(i) != i * 2) return false;
+  }
+  return true;
+}
+
+bool test_remove_copy() {
+  Records arr = records();
+  Records copy = arr;
+  arr.remove(0);
+
+  return arr.size() == 3 && arr.get<2>(0) == "a" && copy.size() == 4 && copy != arr
+    && copy.filter([](const int& id, const double&, const std::string&) { return id != 3; }) == arr;
+}
+
+struct Throwing {
+  Throwing() {}
+  Throwing(int value) : value(value) {
+    if (value < 0) throw value;
+  }
+
+  bool operator==(const Throwing& rhs) const { return value == rhs.value; }
+
+  int value = 0;
+};
+
+bool test_emplace_throws() {
+  mrt::SoAArray<int, Throwing> arr;
+  arr.emplace(1, 1);
+
+  try {
+    arr.emplace(2, -1);
+  } catch (int) {}
+
+  return arr.size() == 1 && arr.column<0>().size() == 1 && arr.column<1>().size() == 1;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("soa_array");
+
+  framework.addTests({
+    {"test_append", test_append},
+    {"test_columns", test_columns},
+    {"test_rows", test_rows},
+    {"test_iterate", test_iterate},
+    {"test_foreach_reduce", test_foreach_reduce},
+    {"test_filter", test_filter},
+    {"test_sort", test_sort},
+    {"test_sort_large", test_sort_large},
+    {"test_remove_copy", test_remove_copy},
+    {"test_emplace_throws", test_emplace_throws},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,163 @@
+#include "test.h"
+#include <mrt/sorted_array.h>
+#include <mrt/array.h>
+#include <algorithm>
+#include <string>
+#include <cstdio>
+
+bool test_insert() {
+  mrt::SortedArray<int> arr;
+
+  for (int x : {5, 1, 4, 1, 3, 9, 2}) {
+    arr.insert(x);
+  }
+
+  return mrt::Array<int>(arr.view()) == mrt::Array<int>{1, 1, 2, 3, 4, 5, 9} && arr.first() == 1 && arr.last() == 9;
+}
+
+bool test_bounds() {
+  mrt::SortedArray<int> arr = {1, 3, 3, 3, 5, 7};
+
+  auto [lower, upper] = arr.equalRange(3);
+
+  return arr.lowerBound(0) == 0 && arr.lowerBound(3) == 1 && arr.upperBound(3) == 4
+    && arr.lowerBound(4) == 4 && arr.upperBound(7) == 6 && arr.lowerBound(8) == 6
+    && lower == 1 && upper == 4 && arr.count(3) == 3 && arr.count(4) == 0;
+}
+
+bool test_bounds_exhaustive() {
+  // Every size up to 64, every probe between and around the elements
+  for (int n = 0; n <= 64; n++) {
+    mrt::SortedArray<int> arr;
+    for (int i = 0; i < n; i++) {
+      arr.insert(i * 2);
+    }
+    for (int probe = -1; probe <= n * 2; probe++) {
+      // Elements less than probe, elements not greater than probe
+      size_t less = probe < 0 ? 0 : (probe + 1) / 2;
+      size_t notGreater = probe < 0 ? 0 : (size_t) std::min(n, probe / 2 + 1);
+      if (arr.lowerBound(probe) != less || arr.upperBound(probe) != notGreater) return false;
+      if (arr.contains(probe) != (probe >= 0 && probe % 2 == 0 && probe < n * 2)) return false;
+    }
+  }
+  return true;
+}
+
+bool test_search() {
+  mrt::SortedArray<std::string> arr = {"pear", "apple", "fig", "kiwi"};
+
+  return arr.binarySearch("fig") == 1 && arr.binarySearch("grape") == mrt::nidx
+    && arr.contains("pear") && !arr.contains("plum");
+}
+
+bool test_insert_many() {
+  mrt::SortedArray<int> arr = {10, 20, 30};
+  mrt::Array<int> batch = {25, 5, 30, 15, 40};
+
+  arr.insertMany(batch);
+  arr.insertMany(mrt::Array<int>{50, 45});
+
+  return mrt::Array<int>(arr.view()) == mrt::Array<int>{5, 10, 15, 20, 25, 30, 30, 40, 45, 50};
+}
+
+bool test_insert_many_large() {
+  mrt::SortedArray<unsigned> arr;
+  mrt::Array<unsigned> batch;
+
+  for (unsigned round = 0; round < 10; round++) {
+    batch.clear();
+    for (unsigned i = 0; i < 1000; i++) {
+      batch.append((i * 7919 + round * 104729) % 100000);
+    }
+    arr.insertMany(batch);
+  }
+
+  for (size_t i = 1; i < arr.size(); i++) {
+    if (arr[i] < arr[i - 1]) return false;
+  }
+  return arr.size() == 10000;
+}
+
+bool test_comparator() {
+  mrt::SortedArray<int, mrt::Descending<int>> arr = {1, 5, 3};
+  arr.insert(4);
+
+  return mrt::Array<int>(arr.view()) == mrt::Array<int>{5, 4, 3, 1} && arr.lowerBound(3) == 2 && arr.contains(5);
+}
+
+bool test_remove() {
+  mrt::SortedArray<int> arr = {1, 2, 2, 2, 3};
+
+  size_t removed = arr.removeAll(2);
+  arr.remove(0);
+
+  return removed == 3 && arr.size() == 1 && arr[0] == 3 && arr.removeAll(7) == 0;
+}
+
+bool test_functional() {
+  mrt::SortedArray<int> arr = {4, 2, 3, 1};
+
+  auto even = arr.filter([](const int& x) { return x % 2 == 0; });
+  int sum = arr.reduce([](int acc, const int& x) { return acc + x; });
+
+  int previous = 0;
+  bool ordered = true;
+  for (const int& x : arr) {
+    if (x < previous) ordered = false;
+    previous = x;
+  }
+
+  return even == mrt::SortedArray<int>{2, 4} && sum == 10 && ordered;
+}
+
+struct Record {
+  int key;
+  int order;
+
+  bool operator==(const Record&) const = default;
+};
+
+struct ByKey {
+  bool operator()(const Record& lhs, const Record& rhs) const { return lhs.key < rhs.key; }
+};
+
+// Equal keys keep insertion order, on every insert path
+bool test_insert_many_stable() {
+  mrt::Array<Record> batch;
+  for (int i = 0; i < 200; i++) {
+    batch.append(Record{(i * 7) % 5, i});
+  }
+
+  mrt::SortedArray<Record, ByKey> many(batch);
+  mrt::SortedArray<Record, ByKey> single;
+  for (const Record& record : batch) {
+    single.insert(record);
+  }
+  many.insertMany(mrt::Array<Record>{{2, 200}, {0, 201}, {2, 202}});
+  single.insert(Record{2, 200});
+  single.insert(Record{0, 201});
+  single.insert(Record{2, 202});
+
+  mrt::SortedArray<Record, ByKey> list = {{1, 0}, {0, 1}, {1, 2}, {0, 3}};
+
+  return many == single && list.toArray() == mrt::Array<Record>{{0, 1}, {0, 3}, {1, 0}, {1, 2}};
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("sorted_array");
+
+  framework.addTests({
+    {"test_insert", test_insert},
+    {"test_bounds", test_bounds},
+    {"test_bounds_exhaustive", test_bounds_exhaustive},
+    {"test_search", test_search},
+    {"test_insert_many", test_insert_many},
+    {"test_insert_many_large", test_insert_many_large},
+    {"test_comparator", test_comparator},
+    {"test_remove", test_remove},
+    {"test_functional", test_functional},
+    {"test_insert_many_stable", test_insert_many_stable},
+  });
+
+  return framework.run(argc, argv);
+}
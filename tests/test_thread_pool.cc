@@ -0,0 +1,83 @@
+#include "test.h"
+#include <mrt/thread_pool.h>
+#include <stdexcept>
+#include <atomic>
+#include <vector>
+
+bool test_submit() {
+  std::atomic<int> count = 0;
+  {
+    mrt::ThreadPool pool(4);
+    for (int i = 0; i < 100; i++) {
+      pool.submit([&count]() { count++; });
+    }
+  }
+
+  return count == 100;
+}
+
+bool test_parallel_for() {
+  mrt::ThreadPool pool(4);
+  std::vector<int> values(1000, 0);
+
+  pool.parallelFor(values.size(), 64, [&values](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      values[i] = i;
+    }
+  });
+
+  for (size_t i = 0; i < values.size(); i++) {
+    if (values[i] != i) return false;
+  }
+  return true;
+}
+
+bool test_single_thread() {
+  mrt::ThreadPool pool(1);
+  size_t chunks = 0;
+
+  pool.parallelFor(10, 3, [&chunks](size_t begin, size_t end) { chunks++; });
+
+  return pool.threads() == 1 && chunks == 4;
+}
+
+bool test_nested() {
+  mrt::ThreadPool pool(2);
+  std::atomic<int> count = 0;
+
+  pool.parallelFor(8, 1, [&pool, &count](size_t, size_t) {
+    pool.parallelFor(8, 1, [&count](size_t, size_t) { count++; });
+  });
+
+  return count == 64;
+}
+
+bool test_exception() {
+  mrt::ThreadPool pool(4);
+  std::atomic<int> count = 0;
+
+  try {
+    pool.parallelFor(100, 1, [&count](size_t begin, size_t end) {
+      count++;
+      if (begin == 50) throw std::runtime_error("chunk failed");
+    });
+  } catch (const std::runtime_error&) {
+    return count == 100;
+  }
+
+  return false;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("thread_pool");
+
+  framework.addTests({
+    {"test_submit", test_submit},
+    {"test_parallel_for", test_parallel_for},
+    {"test_single_thread", test_single_thread},
+    {"test_nested", test_nested},
+    {"test_exception", test_exception},
+  });
+
+  return framework.run(argc, argv);
+}
@@ -0,0 +1,109 @@
+#include "test.h"
+#include <mrt/generator.h>
+#include <mrt/flat_map.h>
+#include <mrt/string.h>
+#include <mrt/array.h>
+#include <mrt/list.h>
+#include <mrt/view.h>
+#include <mrt/map.h>
+#include <string>
+#include <cstdio>
+
+bool test_filter_map_reduce() {
+  mrt::Array<int> arr = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  int result = arr.view()
+    .filter([](const int& x) { return x % 2 == 0; })
+    .map([](const int& x) { return x * 10; })
+    .reduce([](int s, const int& x) { return s + x; });
+
+  return result == 200;
+}
+
+bool test_take() {
+  mrt::Array<int> arr = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  mrt::Array<int> expected = {1, 3, 5};
+  int visited = 0;
+
+  auto result = arr.view()
+    .filter([&visited](const int& x) { visited++; return x % 2 == 1; })
+    .take(3)
+    .collect();
+
+  // Source stops at 5, elements after it are never read
+  return result == expected && visited == 6 && arr.view().take(0).count() == 0;
+}
+
+bool test_skip() {
+  mrt::Array<int> arr = {0, 1, 2, 3, 4, 5};
+  mrt::Array<int> expected = {2, 3};
+
+  return arr.view().skip(2).take(2).collect() == expected && arr.view().skip(10).count() == 0;
+}
+
+bool test_map_type() {
+  mrt::Array<int> arr = {1, 2, 3};
+  mrt::Array<std::string> expected = {"1", "2", "3"};
+
+  return arr.view().map([](const int& x) { return std::to_string(x); }).collect() == expected;
+}
+
+bool test_rerun() {
+  mrt::Array<int> arr = {1, 2, 3, 4};
+  auto view = arr.view().skip(1).take(2);
+
+  return view.count() == 2 && view.count() == 2 && view.reduce([](int s, const int& x) { return s + x; }) == 5;
+}
+
+bool test_list() {
+  mrt::List<int> list = {5, 4, 3, 2, 1};
+  mrt::List<int> expected = {4, 2};
+
+  return list.view().filter([](const int& x) { return x % 2 == 0; }).collect<mrt::List<int>>() == expected;
+}
+
+bool test_map() {
+  mrt::Map<mrt::String, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  int sum = map.view()
+    .filter([](const mrt::Pair<mrt::String, int>& p) { return p._1 != "b"; })
+    .map([](const mrt::Pair<mrt::String, int>& p) { return p._2; })
+    .reduce([](int s, const int& x) { return s + x; });
+
+  return sum == 4 && map.view().take(2).count() == 2;
+}
+
+bool test_flat_map() {
+  mrt::FlatMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.set(i, i * 2);
+  }
+
+  auto values = map.view().map([](const mrt::Pair<int, int>& p) { return p._2; }).filter([](const int& x) { return x >= 100; }).collect();
+
+  return values.size() == 50 && map.view().take(10).count() == 10;
+}
+
+bool test_generator() {
+  mrt::Array<size_t> expected = {0, 4, 16};
+
+  return mrt::range(100).view().map([](const size_t& x) { return x * x; }).filter([](const size_t& x) { return x % 2 == 0; }).take(3).collect() == expected;
+}
+
+int main(int argc, char ** argv) {
+  mrt::TestFramework framework("view");
+
+  framework.addTests({
+    {"test_filter_map_reduce", test_filter_map_reduce},
+    {"test_take", test_take},
+    {"test_skip", test_skip},
+    {"test_map_type", test_map_type},
+    {"test_rerun", test_rerun},
+    {"test_list", test_list},
+    {"test_map", test_map},
+    {"test_flat_map", test_flat_map},
+    {"test_generator", test_generator},
+  });
+
+  return framework.run(argc, argv);
+}